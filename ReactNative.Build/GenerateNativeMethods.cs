@@ -0,0 +1,147 @@
+﻿using Microsoft.Build.Framework;
+using Microsoft.Build.Utilities;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+
+namespace ReactNative.Build
+{
+    /// <summary>
+    /// Generates the method tables of the native modules in a project
+    /// before it is compiled.
+    /// </summary>
+    /// <remarks>
+    /// Imported through <c>ReactNative.Build.targets</c>. The generated
+    /// files are only rewritten when their contents change, so incremental
+    /// builds of the project are not invalidated.
+    /// </remarks>
+    public sealed class GenerateNativeMethods : Task
+    {
+        private const string WarningCode = "RN0001";
+
+        /// <summary>
+        /// The source files of the project.
+        /// </summary>
+        [Required]
+        public ITaskItem[] Sources { get; set; }
+
+        /// <summary>
+        /// The directory to write the generated files to.
+        /// </summary>
+        [Required]
+        public string OutputDirectory { get; set; }
+
+        /// <summary>
+        /// The conditional compilation symbols of the project.
+        /// </summary>
+        public string DefineConstants { get; set; }
+
+        /// <summary>
+        /// The generated files, to be compiled with the project.
+        /// </summary>
+        [Output]
+        public ITaskItem[] GeneratedFiles { get; set; }
+
+        /// <summary>
+        /// Runs the task.
+        /// </summary>
+        /// <returns><b>true</b> if the task succeeded.</returns>
+        public override bool Execute()
+        {
+            try
+            {
+                var outputDirectory = Path.GetFullPath(OutputDirectory);
+                var options = new CSharpParseOptions(
+                    LanguageVersion.CSharp6,
+                    DocumentationMode.None,
+                    SourceCodeKind.Regular,
+                    GetPreprocessorSymbols());
+
+                var syntaxTrees = new List<SyntaxTree>();
+                foreach (var source in Sources)
+                {
+                    var path = source.GetMetadata("FullPath");
+                    if (!string.Equals(Path.GetExtension(path), ".cs", StringComparison.OrdinalIgnoreCase) ||
+                        path.StartsWith(outputDirectory, StringComparison.OrdinalIgnoreCase))
+                    {
+                        continue;
+                    }
+
+                    syntaxTrees.Add(CSharpSyntaxTree.ParseText(File.ReadAllText(path), options, path));
+                }
+
+                var generatedModules = NativeMethodGenerator.Generate(syntaxTrees, ReportWarning);
+
+                Directory.CreateDirectory(outputDirectory);
+                var paths = new HashSet<string>(StringComparer.OrdinalIgnoreCase);
+                foreach (var generatedModule in generatedModules)
+                {
+                    var path = Path.Combine(outputDirectory, generatedModule.FileName);
+                    WriteIfChanged(path, generatedModule.Text);
+                    paths.Add(path);
+                }
+
+                // Tables of modules that were removed would no longer compile.
+                foreach (var path in Directory.GetFiles(outputDirectory, "*" + GeneratedModule.FileExtension))
+                {
+                    if (!paths.Contains(path))
+                    {
+                        File.Delete(path);
+                    }
+                }
+
+                GeneratedFiles = paths.OrderBy(path => path, StringComparer.OrdinalIgnoreCase).Select(path => new TaskItem(path)).ToArray();
+            }
+            catch (IOException ex)
+            {
+                Log.LogErrorFromException(ex);
+            }
+            catch (UnauthorizedAccessException ex)
+            {
+                Log.LogErrorFromException(ex);
+            }
+
+            return !Log.HasLoggedErrors;
+        }
+
+        private IEnumerable<string> GetPreprocessorSymbols()
+        {
+            if (DefineConstants == null)
+            {
+                return Enumerable.Empty<string>();
+            }
+
+            return DefineConstants
+                .Split(new[] { ';', ',', ' ' }, StringSplitOptions.RemoveEmptyEntries)
+                .Select(symbol => symbol.Trim());
+        }
+
+        private void ReportWarning(FileLinePositionSpan span, string message)
+        {
+            Log.LogWarning(
+                null,
+                WarningCode,
+                null,
+                span.Path,
+                span.StartLinePosition.Line + 1,
+                span.StartLinePosition.Character + 1,
+                span.EndLinePosition.Line + 1,
+                span.EndLinePosition.Character + 1,
+                message);
+        }
+
+        private static void WriteIfChanged(string path, string text)
+        {
+            if (File.Exists(path) && File.ReadAllText(path) == text)
+            {
+                return;
+            }
+
+            File.WriteAllText(path, text, new UTF8Encoding(true));
+        }
+    }
+}
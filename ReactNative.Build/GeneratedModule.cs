@@ -0,0 +1,52 @@
+﻿using System;
+
+namespace ReactNative.Build
+{
+    /// <summary>
+    /// The generated method table of one native module.
+    /// </summary>
+    public sealed class GeneratedModule
+    {
+        /// <summary>
+        /// The extension of generated files.
+        /// </summary>
+        public const string FileExtension = ".NativeMethods.g.cs";
+
+        /// <summary>
+        /// Instantiates the <see cref="GeneratedModule"/>.
+        /// </summary>
+        /// <param name="fullName">The full name of the module class.</param>
+        /// <param name="text">The generated source.</param>
+        public GeneratedModule(string fullName, string text)
+        {
+            if (fullName == null)
+                throw new ArgumentNullException(nameof(fullName));
+            if (text == null)
+                throw new ArgumentNullException(nameof(text));
+
+            FullName = fullName;
+            Text = text;
+        }
+
+        /// <summary>
+        /// The full name of the module class.
+        /// </summary>
+        public string FullName { get; }
+
+        /// <summary>
+        /// The name of the generated file.
+        /// </summary>
+        public string FileName
+        {
+            get
+            {
+                return FullName.Replace('`', '_') + FileExtension;
+            }
+        }
+
+        /// <summary>
+        /// The generated source.
+        /// </summary>
+        public string Text { get; }
+    }
+}
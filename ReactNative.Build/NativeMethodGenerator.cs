@@ -0,0 +1,458 @@
+﻿using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp;
+using Microsoft.CodeAnalysis.CSharp.Syntax;
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Linq;
+using System.Text;
+
+namespace ReactNative.Build
+{
+    /// <summary>
+    /// Emits the <c>CreateGeneratedMethods</c> override of each partial
+    /// native module, so its methods are bound without reflection or
+    /// expression compilation at runtime.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The generator works on syntax alone, so it can run before the project
+    /// is compiled. Parameter types are matched by name in the way the
+    /// runtime matches them by type, and are copied into the generated
+    /// source along with the using directives of the module's files.
+    /// </para>
+    /// <para>
+    /// Modules that are not partial, or that already override the method,
+    /// are left to the runtime. So are partial modules with a method the
+    /// generator cannot bind, which are reported as warnings.
+    /// </para>
+    /// </remarks>
+    public static class NativeMethodGenerator
+    {
+        private const string GeneratedMethodName = "CreateGeneratedMethods";
+        private const string Bridge = "global::ReactNative.Bridge.";
+        private const string EventSource = "global::ReactNative.Tracing.ReactEventSource";
+
+        /// <summary>
+        /// Generates the method tables of the modules declared in the
+        /// syntax trees.
+        /// </summary>
+        /// <param name="syntaxTrees">The syntax trees of the project.</param>
+        /// <param name="reportWarning">Reports a module that is left to the runtime.</param>
+        /// <returns>The generated sources, one per module.</returns>
+        public static IList<GeneratedModule> Generate(IEnumerable<SyntaxTree> syntaxTrees, Action<FileLinePositionSpan, string> reportWarning)
+        {
+            if (syntaxTrees == null)
+                throw new ArgumentNullException(nameof(syntaxTrees));
+            if (reportWarning == null)
+                throw new ArgumentNullException(nameof(reportWarning));
+
+            // Partial declarations of a module may be spread across files.
+            var modules = new Dictionary<string, List<ClassDeclarationSyntax>>(StringComparer.Ordinal);
+            foreach (var syntaxTree in syntaxTrees)
+            {
+                foreach (var declaration in syntaxTree.GetCompilationUnitRoot().DescendantNodes().OfType<ClassDeclarationSyntax>())
+                {
+                    var fullName = GetFullName(declaration);
+                    var declarations = default(List<ClassDeclarationSyntax>);
+                    if (!modules.TryGetValue(fullName, out declarations))
+                    {
+                        declarations = new List<ClassDeclarationSyntax>();
+                        modules.Add(fullName, declarations);
+                    }
+
+                    declarations.Add(declaration);
+                }
+            }
+
+            var generatedModules = new List<GeneratedModule>();
+            foreach (var entry in modules.OrderBy(entry => entry.Key, StringComparer.Ordinal))
+            {
+                var generatedModule = Generate(entry.Key, entry.Value, reportWarning);
+                if (generatedModule != null)
+                {
+                    generatedModules.Add(generatedModule);
+                }
+            }
+
+            return generatedModules;
+        }
+
+        private static GeneratedModule Generate(string fullName, IList<ClassDeclarationSyntax> declarations, Action<FileLinePositionSpan, string> reportWarning)
+        {
+            var allMethods = declarations.SelectMany(declaration => declaration.Members.OfType<MethodDeclarationSyntax>()).ToList();
+            var methods = allMethods.Where(IsReactMethod).ToList();
+            if (methods.Count == 0 ||
+                !declarations.Any(IsPartial) ||
+                allMethods.Any(method => method.Identifier.ValueText == GeneratedMethodName))
+            {
+                return null;
+            }
+
+            var first = declarations[0];
+            foreach (var containingType in first.Ancestors().OfType<TypeDeclarationSyntax>())
+            {
+                if (!IsPartial(containingType))
+                {
+                    Report(reportWarning, first, fullName, string.Format(
+                        CultureInfo.InvariantCulture,
+                        "is declared in '{0}', which is not partial",
+                        containingType.Identifier.ValueText));
+
+                    return null;
+                }
+            }
+
+            var names = new HashSet<string>(StringComparer.Ordinal);
+            foreach (var method in methods)
+            {
+                var reason = GetUnsupportedReason(method);
+                if (reason == null && !names.Add(method.Identifier.ValueText))
+                {
+                    reason = "is overloaded";
+                }
+
+                if (reason != null)
+                {
+                    Report(reportWarning, method, fullName, string.Format(
+                        CultureInfo.InvariantCulture,
+                        "has a method '{0}' that {1}",
+                        method.Identifier.ValueText,
+                        reason));
+
+                    return null;
+                }
+            }
+
+            return new GeneratedModule(fullName, Emit(declarations, methods));
+        }
+
+        private static string Emit(IList<ClassDeclarationSyntax> declarations, IList<MethodDeclarationSyntax> methods)
+        {
+            var writer = new SourceWriter();
+            writer.WriteLine("// <auto-generated>");
+            writer.WriteLine("//     Generated by ReactNative.Build from the [ReactMethod] methods of the");
+            writer.WriteLine("//     module. Changes to this file are lost when it is regenerated.");
+            writer.WriteLine("// </auto-generated>");
+
+            // Parameter types are written as they appear in the module's files.
+            var fileUsings = declarations
+                .SelectMany(declaration => declaration.SyntaxTree.GetCompilationUnitRoot().Usings)
+                .Select(directive => directive.ToString())
+                .Distinct(StringComparer.Ordinal)
+                .ToList();
+
+            foreach (var directive in fileUsings)
+            {
+                writer.WriteLine(directive);
+            }
+
+            var first = declarations[0];
+            var namespaces = first.Ancestors().OfType<NamespaceDeclarationSyntax>().Reverse().ToList();
+            if (namespaces.Count > 0)
+            {
+                writer.WriteLine();
+                writer.WriteLine("namespace " + string.Join(".", namespaces.Select(declaration => declaration.Name.ToString())));
+                writer.OpenBlock();
+
+                var namespaceUsings = declarations
+                    .SelectMany(declaration => declaration.Ancestors().OfType<NamespaceDeclarationSyntax>())
+                    .SelectMany(declaration => declaration.Usings)
+                    .Select(directive => directive.ToString())
+                    .Distinct(StringComparer.Ordinal)
+                    .ToList();
+
+                foreach (var directive in namespaceUsings)
+                {
+                    writer.WriteLine(directive);
+                }
+
+                if (namespaceUsings.Count > 0)
+                {
+                    writer.WriteLine();
+                }
+            }
+            else
+            {
+                writer.WriteLine();
+            }
+
+            var types = first.Ancestors().OfType<TypeDeclarationSyntax>().Reverse().Concat(new[] { first }).ToList();
+            foreach (var type in types)
+            {
+                writer.WriteLine("partial " + type.Keyword.ValueText + " " + type.Identifier.Text + (type.TypeParameterList?.ToString() ?? ""));
+                writer.OpenBlock();
+            }
+
+            writer.WriteLine("protected override global::System.Collections.Generic.IReadOnlyDictionary<string, " + Bridge + "INativeMethod> " + GeneratedMethodName + "()");
+            writer.OpenBlock();
+            writer.WriteLine("return new global::System.Collections.Generic.Dictionary<string, " + Bridge + "INativeMethod>");
+            writer.OpenBlock();
+            foreach (var method in methods)
+            {
+                EmitMethod(writer, method);
+            }
+
+            writer.CloseBlock(";");
+            writer.CloseBlock();
+
+            foreach (var type in types)
+            {
+                writer.CloseBlock();
+            }
+
+            if (namespaces.Count > 0)
+            {
+                writer.CloseBlock();
+            }
+
+            return writer.ToString();
+        }
+
+        private static void EmitMethod(SourceWriter writer, MethodDeclarationSyntax method)
+        {
+            var parameters = method.ParameterList.Parameters;
+            var isAsync = IsTask(method.ReturnType);
+            var name = method.Identifier.ValueText;
+            var arguments = string.Join(", ", parameters.Select((parameter, i) => "p" + i));
+            var call = "this." + method.Identifier.Text + "(" + arguments + ")";
+            var trace =
+                "if (" + EventSource + ".Log.IsEnabled(" + EventSource + ".Keywords.NativeCall)) " +
+                EventSource + ".Log.NativeCallArgumentsDecoded(\"NativeCall__\" + this.Name + \"_" + name + "\");";
+
+            writer.OpenBlock();
+            writer.WriteLine("\"" + name + "\",");
+            writer.WriteLine("new " + Bridge + "GeneratedNativeMethod(");
+            writer.Indent();
+            writer.WriteLine(isAsync ? "\"remoteAsync\"," : "\"remote\",");
+
+            //
+            // The JSON array invoker mirrors the expression the runtime
+            // compiles, and takes the promise callbacks after the declared
+            // parameters.
+            //
+            writer.WriteLine("(catalystInstance, arguments) =>");
+            writer.OpenBlock();
+            writer.WriteLine(Bridge + "NativeArguments.CheckArgumentCount(arguments, " + (isAsync ? parameters.Count + 2 : parameters.Count).ToString(CultureInfo.InvariantCulture) + ");");
+            for (var i = 0; i < parameters.Count; ++i)
+            {
+                var index = i.ToString(CultureInfo.InvariantCulture);
+                writer.WriteLine("var p" + index + " = " + (IsCallback(parameters[i].Type)
+                    ? Bridge + "NativeArguments.ExtractCallback(arguments[" + index + "], catalystInstance);"
+                    : Bridge + "NativeArguments.Extract<" + parameters[i].Type + ">(arguments[" + index + "]);"));
+            }
+
+            if (isAsync)
+            {
+                writer.WriteLine("var resolve = " + Bridge + "NativeArguments.ExtractCallback(arguments[" + parameters.Count.ToString(CultureInfo.InvariantCulture) + "], catalystInstance);");
+                writer.WriteLine("var reject = " + Bridge + "NativeArguments.ExtractCallback(arguments[" + (parameters.Count + 1).ToString(CultureInfo.InvariantCulture) + "], catalystInstance);");
+            }
+
+            writer.WriteLine(trace);
+            writer.WriteLine(isAsync ? Bridge + "NativePromise.Bind(" + call + ", resolve, reject);" : call + ";");
+            writer.CloseBlock(",");
+
+            // The reader invoker streams each argument in order, as above.
+            writer.WriteLine("(catalystInstance, reader) =>");
+            writer.OpenBlock();
+            for (var i = 0; i < parameters.Count; ++i)
+            {
+                writer.WriteLine("var p" + i.ToString(CultureInfo.InvariantCulture) + " = " + GetReadExpression(parameters[i].Type) + ";");
+            }
+
+            if (isAsync)
+            {
+                writer.WriteLine("var resolve = " + Bridge + "NativeArguments.ReadCallback(reader, catalystInstance);");
+                writer.WriteLine("var reject = " + Bridge + "NativeArguments.ReadCallback(reader, catalystInstance);");
+            }
+
+            writer.WriteLine(Bridge + "NativeArguments.ReadEndArray(reader);");
+            writer.WriteLine(trace);
+            writer.WriteLine(isAsync ? Bridge + "NativePromise.Bind(" + call + ", resolve, reject);" : call + ";");
+            writer.CloseBlock(")");
+            writer.Outdent();
+            writer.CloseBlock(",");
+        }
+
+        private static string GetReadExpression(TypeSyntax type)
+        {
+            if (IsCallback(type))
+            {
+                return Bridge + "NativeArguments.ReadCallback(reader, catalystInstance)";
+            }
+
+            var predefinedType = type as PredefinedTypeSyntax;
+            if (predefinedType != null)
+            {
+                switch (predefinedType.Keyword.Kind())
+                {
+                    case SyntaxKind.IntKeyword:
+                        return Bridge + "NativeArguments.ReadInt32(reader)";
+                    case SyntaxKind.DoubleKeyword:
+                        return Bridge + "NativeArguments.ReadDouble(reader)";
+                    case SyntaxKind.BoolKeyword:
+                        return Bridge + "NativeArguments.ReadBoolean(reader)";
+                    case SyntaxKind.StringKeyword:
+                        return Bridge + "NativeArguments.ReadString(reader)";
+                }
+            }
+
+            return Bridge + "NativeArguments.Read<" + type + ">(reader)";
+        }
+
+        private static string GetUnsupportedReason(MethodDeclarationSyntax method)
+        {
+            if (method.Modifiers.Any(SyntaxKind.StaticKeyword))
+            {
+                return "is static";
+            }
+
+            if (method.TypeParameterList != null)
+            {
+                return "is generic";
+            }
+
+            foreach (var parameter in method.ParameterList.Parameters)
+            {
+                if (parameter.Modifiers.Any(SyntaxKind.RefKeyword) ||
+                    parameter.Modifiers.Any(SyntaxKind.OutKeyword) ||
+                    parameter.Modifiers.Any(SyntaxKind.ParamsKeyword) ||
+                    parameter.Modifiers.Any(SyntaxKind.ThisKeyword))
+                {
+                    return string.Format(
+                        CultureInfo.InvariantCulture,
+                        "has a '{0}' parameter",
+                        parameter.Modifiers.First().ValueText);
+                }
+            }
+
+            return null;
+        }
+
+        private static bool IsReactMethod(MethodDeclarationSyntax method)
+        {
+            return method.AttributeLists
+                .SelectMany(list => list.Attributes)
+                .Select(attribute => GetSimpleName(attribute.Name))
+                .Any(name => name == "ReactMethod" || name == "ReactMethodAttribute");
+        }
+
+        private static bool IsPartial(TypeDeclarationSyntax declaration)
+        {
+            return declaration.Modifiers.Any(SyntaxKind.PartialKeyword);
+        }
+
+        private static bool IsCallback(TypeSyntax type)
+        {
+            var name = type as NameSyntax;
+            return name != null && GetSimpleName(name) == "ICallback";
+        }
+
+        private static bool IsTask(TypeSyntax type)
+        {
+            var name = type as NameSyntax;
+            return name != null && GetSimpleName(name) == "Task";
+        }
+
+        private static string GetSimpleName(NameSyntax name)
+        {
+            var qualifiedName = name as QualifiedNameSyntax;
+            if (qualifiedName != null)
+            {
+                return GetSimpleName(qualifiedName.Right);
+            }
+
+            var aliasQualifiedName = name as AliasQualifiedNameSyntax;
+            if (aliasQualifiedName != null)
+            {
+                return aliasQualifiedName.Name.Identifier.ValueText;
+            }
+
+            return ((SimpleNameSyntax)name).Identifier.ValueText;
+        }
+
+        private static string GetFullName(ClassDeclarationSyntax declaration)
+        {
+            var parts = new List<string>();
+            foreach (var ancestor in declaration.AncestorsAndSelf())
+            {
+                var type = ancestor as TypeDeclarationSyntax;
+                if (type != null)
+                {
+                    var arity = type.TypeParameterList?.Parameters.Count ?? 0;
+                    parts.Add(arity > 0
+                        ? type.Identifier.ValueText + "`" + arity.ToString(CultureInfo.InvariantCulture)
+                        : type.Identifier.ValueText);
+                }
+
+                var namespaceDeclaration = ancestor as NamespaceDeclarationSyntax;
+                if (namespaceDeclaration != null)
+                {
+                    parts.Add(namespaceDeclaration.Name.ToString());
+                }
+            }
+
+            parts.Reverse();
+            return string.Join(".", parts);
+        }
+
+        private static void Report(Action<FileLinePositionSpan, string> reportWarning, SyntaxNode node, string fullName, string reason)
+        {
+            reportWarning(
+                node.GetLocation().GetLineSpan(),
+                string.Format(
+                    CultureInfo.InvariantCulture,
+                    "Native module '{0}' {1}, so its methods are compiled at runtime.",
+                    fullName,
+                    reason));
+        }
+
+        class SourceWriter
+        {
+            private readonly StringBuilder _builder = new StringBuilder();
+            private int _indent;
+
+            public void Indent()
+            {
+                _indent++;
+            }
+
+            public void Outdent()
+            {
+                _indent--;
+            }
+
+            public void OpenBlock()
+            {
+                WriteLine("{");
+                Indent();
+            }
+
+            public void CloseBlock()
+            {
+                CloseBlock("");
+            }
+
+            public void CloseBlock(string suffix)
+            {
+                Outdent();
+                WriteLine("}" + suffix);
+            }
+
+            public void WriteLine()
+            {
+                _builder.Append('\n');
+            }
+
+            public void WriteLine(string line)
+            {
+                _builder.Append(' ', _indent * 4).Append(line).Append('\n');
+            }
+
+            public override string ToString()
+            {
+                return _builder.ToString();
+            }
+        }
+    }
+}
@@ -0,0 +1,195 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using ReactNative.Bridge;
+using ReactNative.Bridge.Queue;
+using ReactNative.Hosting;
+using System;
+using System.Text;
+using System.Threading.Tasks;
+using Windows.Storage;
+
+namespace ReactNative.Tests.Bridge
+{
+    [TestClass]
+    public class JavaScriptBundleLoaderTests
+    {
+        private const string FolderName = "JavaScriptBundleLoaderTests";
+        private const string FolderUri = "ms-appdata:///local/" + FolderName + "/";
+
+        [TestMethod]
+        public void JavaScriptBundleLoader_ArgumentChecks()
+        {
+            AssertEx.Throws<ArgumentNullException>(
+                () => JavaScriptBundleLoader.CreateSegmentedFileLoader(null),
+                ex => Assert.AreEqual("indexFileName", ex.ParamName));
+
+            using (var loader = JavaScriptBundleLoader.CreateSegmentedFileLoader(FolderUri + "index.json"))
+            {
+                AssertEx.Throws<ArgumentNullException>(
+                    () => loader.ParseScript(null),
+                    ex => Assert.AreEqual("bridge", ex.ParamName));
+            }
+        }
+
+        [TestMethod]
+        public async Task JavaScriptBundleLoader_Segmented_InvalidIndex()
+        {
+            await WriteFileAsync("invalid.json", "{ \"startup\": \"startup.js\", \"segments\": { \"a\": 42 } }");
+
+            using (var loader = JavaScriptBundleLoader.CreateSegmentedFileLoader(FolderUri + "invalid.json"))
+            {
+                var exception = default(InvalidOperationException);
+                try
+                {
+                    await loader.InitializeAsync();
+                }
+                catch (InvalidOperationException ex)
+                {
+                    exception = ex;
+                }
+
+                Assert.IsNotNull(exception);
+                StringAssert.Contains(exception.Message, "invalid.json");
+            }
+        }
+
+        [TestMethod]
+        public async Task JavaScriptBundleLoader_Segmented_RequireSegment()
+        {
+            await WriteFileAsync("index.json", "{ \"startup\": \"startup.js\", \"segments\": { \"a\": \"a.js\", \"b\": { \"script\": \"b.js\", \"serializedScript\": \"b.bin\" } } }");
+            await WriteFileAsync("startup.js", "var aCount = 0, bCount = 0;");
+            await WriteFileAsync("a.js", "++aCount;");
+
+            // The serialized script is garbage, so the loader falls back to the source.
+            var folder = await GetFolderAsync();
+            var scriptFile = await folder.CreateFileAsync("b.js", CreationCollisionOption.ReplaceExisting);
+            await FileIO.WriteBytesAsync(scriptFile, Encoding.Unicode.GetBytes("++bCount;\0"));
+            var serializedScriptFile = await folder.CreateFileAsync("b.bin", CreationCollisionOption.ReplaceExisting);
+            await FileIO.WriteBytesAsync(serializedScriptFile, new byte[] { 0xDE, 0xAD, 0xBE, 0xEF, 0, 0, 0, 0 });
+
+            using (var loader = JavaScriptBundleLoader.CreateSegmentedFileLoader(FolderUri + "index.json"))
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var pool = new JavaScriptInstancePool(thread, loader, 0))
+                using (var first = await pool.AcquireAsync(new NullReactCallback()))
+                using (var second = await pool.AcquireAsync(new NullReactCallback()))
+                {
+                    // A segment runs once per context.
+                    Assert.AreEqual(1.0, await first.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("nativeRequireSegment('a'); nativeRequireSegment('a'); aCount").ToDouble()));
+                    Assert.AreEqual(1.0, await second.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("nativeRequireSegment('a'); aCount").ToDouble()));
+
+                    Assert.AreEqual(1.0, await first.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("nativeRequireSegment('b'); nativeRequireSegment('b'); bCount").ToDouble()));
+                    Assert.AreEqual(1.0, await second.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("nativeRequireSegment('b'); bCount").ToDouble()));
+
+                    // Unknown segments surface as script errors.
+                    Assert.AreEqual("Unknown bundle segment 'c'.", await first.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("try { nativeRequireSegment('c'); } catch (e) { e.message; }").ToString()));
+                }
+            }
+        }
+
+        [TestMethod]
+        public async Task JavaScriptBundleLoader_Segmented_UnterminatedScript()
+        {
+            await WriteFileAsync("unterminated.json", "{ \"startup\": \"startup.js\", \"segments\": { \"c\": { \"script\": \"c.js\", \"serializedScript\": \"c.bin\" } } }");
+            await WriteFileAsync("startup.js", "var aCount = 0, bCount = 0;");
+
+            // A mapped source must end in a null character for Chakra to stop.
+            var folder = await GetFolderAsync();
+            var scriptFile = await folder.CreateFileAsync("c.js", CreationCollisionOption.ReplaceExisting);
+            await FileIO.WriteBytesAsync(scriptFile, Encoding.Unicode.GetBytes("++bCount;"));
+            var serializedScriptFile = await folder.CreateFileAsync("c.bin", CreationCollisionOption.ReplaceExisting);
+            await FileIO.WriteBytesAsync(serializedScriptFile, new byte[] { 0xDE, 0xAD, 0xBE, 0xEF, 0, 0, 0, 0 });
+
+            using (var loader = JavaScriptBundleLoader.CreateSegmentedFileLoader(FolderUri + "unterminated.json"))
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var pool = new JavaScriptInstancePool(thread, loader, 0))
+                using (var instance = await pool.AcquireAsync(new NullReactCallback()))
+                {
+                    var message = await instance.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("try { nativeRequireSegment('c'); } catch (e) { e.message; }").ToString());
+                    StringAssert.Contains(message, "is not a null-terminated UTF-16 script");
+                }
+            }
+        }
+
+        [TestMethod]
+        public async Task JavaScriptBundleLoader_SetGlobalFunction()
+        {
+            var loader = new GlobalFunctionBundleLoader();
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var pool = new JavaScriptInstancePool(thread, loader, 0))
+                using (var instance = await pool.AcquireAsync(new NullReactCallback()))
+                {
+                    await instance.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("nativeRecord(1, 'two', { three: [3] });"));
+
+                    Assert.IsNotNull(loader.Arguments);
+                    Assert.AreEqual(3, loader.Arguments.Count);
+                    Assert.AreEqual(1, loader.Arguments[0].Value<int>());
+                    Assert.AreEqual("two", loader.Arguments[1].Value<string>());
+                    Assert.AreEqual(3, loader.Arguments[2]["three"][0].Value<int>());
+
+                    // Exceptions from the native function are thrown in script.
+                    Assert.AreEqual("Expected arguments.", await instance.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("try { nativeRecord(); } catch (e) { e.message; }").ToString()));
+                }
+            }
+        }
+
+        private static async Task<StorageFolder> GetFolderAsync()
+        {
+            return await ApplicationData.Current.LocalFolder.CreateFolderAsync(FolderName, CreationCollisionOption.OpenIfExists);
+        }
+
+        private static async Task WriteFileAsync(string name, string contents)
+        {
+            var folder = await GetFolderAsync();
+            var file = await folder.CreateFileAsync(name, CreationCollisionOption.ReplaceExisting);
+            await FileIO.WriteTextAsync(file, contents);
+        }
+
+        class GlobalFunctionBundleLoader : JavaScriptBundleLoader
+        {
+            public JArray Arguments { get; private set; }
+
+            public override string SourceUrl
+            {
+                get
+                {
+                    return "global.js";
+                }
+            }
+
+            public override Task InitializeAsync()
+            {
+                return Task.FromResult(true);
+            }
+
+            public override void LoadScript(IReactBridge bridge)
+            {
+                bridge.SetGlobalFunction("nativeRecord", arguments =>
+                {
+                    if (arguments.Count == 0)
+                    {
+                        throw new ArgumentException("Expected arguments.");
+                    }
+
+                    Arguments = arguments;
+                });
+            }
+        }
+
+        class NullReactCallback : IReactCallback
+        {
+            public void Invoke(JsonReader batch)
+            {
+            }
+        }
+    }
+}
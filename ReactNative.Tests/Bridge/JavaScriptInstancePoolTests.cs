@@ -0,0 +1,160 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using ReactNative.Bridge;
+using ReactNative.Bridge.Queue;
+using ReactNative.Hosting;
+using System;
+using System.Threading.Tasks;
+
+namespace ReactNative.Tests.Bridge
+{
+    [TestClass]
+    public class JavaScriptInstancePoolTests
+    {
+        [TestMethod]
+        public void JavaScriptInstancePool_ArgumentChecks()
+        {
+            var loader = new TestBundleLoader("var counter = 0;");
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                AssertEx.Throws<ArgumentNullException>(
+                    () => new JavaScriptInstancePool(null, loader, 1),
+                    ex => Assert.AreEqual("jsQueueThread", ex.ParamName));
+
+                AssertEx.Throws<ArgumentNullException>(
+                    () => new JavaScriptInstancePool(thread, null, 1),
+                    ex => Assert.AreEqual("coreBundleLoader", ex.ParamName));
+
+                AssertEx.Throws<ArgumentOutOfRangeException>(
+                    () => new JavaScriptInstancePool(thread, loader, -1),
+                    ex => Assert.AreEqual("capacity", ex.ParamName));
+            }
+        }
+
+        [TestMethod]
+        public async Task JavaScriptInstancePool_AcquireAsync()
+        {
+            var loader = new TestBundleLoader("var counter = 0;");
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var pool = new JavaScriptInstancePool(thread, loader, 1))
+                {
+                    pool.Warm();
+
+                    using (var first = await pool.AcquireAsync(new NullReactCallback()))
+                    using (var second = await pool.AcquireAsync(new NullReactCallback()))
+                    {
+                        // Each instance has its own copy of the bundle's globals.
+                        Assert.AreEqual(1.0, await first.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("++counter").ToDouble()));
+                        Assert.AreEqual(2.0, await first.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("++counter").ToDouble()));
+                        Assert.AreEqual(1.0, await second.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("++counter").ToDouble()));
+                    }
+
+                    Assert.AreEqual(1, loader.InitializeCount);
+                    Assert.IsTrue(loader.LoadCount >= 2);
+                }
+            }
+        }
+
+        [TestMethod]
+        public async Task JavaScriptInstancePool_Dispose_ReleasesBridge()
+        {
+            var loader = new TestBundleLoader(
+                "var __fbBatchedBridge = {" +
+                "  callFunctionReturnFlushedQueue: function () { return null; }," +
+                "  invokeCallbackAndReturnFlushedQueue: function () { return null; }" +
+                "};");
+
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var pool = new JavaScriptInstancePool(thread, loader, 0))
+                {
+                    var instance = await pool.AcquireAsync(new NullReactCallback());
+
+                    // Resolve the batched bridge, so the bridge holds references into the context.
+                    await instance.JSQueueThread.CallOnQueue(() =>
+                    {
+                        instance.Bridge.InvokeCallback(1, new JArray());
+                        return true;
+                    });
+
+                    instance.Dispose();
+
+                    // The bridge is released on the queue, before any later work runs.
+                    Assert.IsTrue(await thread.CallOnQueue(() =>
+                    {
+                        JavaScriptContext.Current.Runtime.CollectGarbage();
+                        return true;
+                    }));
+                }
+            }
+        }
+
+        [TestMethod]
+        public async Task JavaScriptInstancePool_AcquireAsync_ThreadDisposed()
+        {
+            var loader = new TestBundleLoader("var counter = 0;");
+            var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler());
+            using (var pool = new JavaScriptInstancePool(thread, loader, 0))
+            {
+                // The thread never starts, so the instance is never created.
+                var acquire = pool.AcquireAsync(new NullReactCallback());
+                thread.Dispose();
+
+                var exception = default(ObjectDisposedException);
+                try
+                {
+                    await acquire;
+                }
+                catch (ObjectDisposedException ex)
+                {
+                    exception = ex;
+                }
+
+                Assert.IsNotNull(exception);
+            }
+        }
+
+        [TestMethod]
+        public async Task JavaScriptInstancePool_AcquireAsync_Disposed()
+        {
+            var loader = new TestBundleLoader("var counter = 0;");
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                var pool = new JavaScriptInstancePool(thread, loader, 1);
+                pool.Dispose();
+
+                // Warming a disposed pool creates nothing.
+                pool.Warm();
+                Assert.IsTrue(await thread.CallOnQueue(() => true));
+                Assert.AreEqual(0, loader.LoadCount);
+
+                var exception = default(ObjectDisposedException);
+                try
+                {
+                    await pool.AcquireAsync(new NullReactCallback());
+                }
+                catch (ObjectDisposedException ex)
+                {
+                    exception = ex;
+                }
+
+                Assert.IsNotNull(exception);
+            }
+        }
+
+        class NullReactCallback : IReactCallback
+        {
+            public void Invoke(JsonReader batch)
+            {
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using ReactNative.Bridge;
+using ReactNative.Bridge.Queue;
+using ReactNative.Hosting;
+using System;
+using System.Threading.Tasks;
+
+namespace ReactNative.Tests.Bridge
+{
+    [TestClass]
+    public class JavaScriptMemoryGovernorTests
+    {
+        [TestMethod]
+        public void JavaScriptMemoryGovernor_ArgumentChecks()
+        {
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                AssertEx.Throws<ArgumentNullException>(
+                    () => new JavaScriptMemoryGovernor(null, new INativeModule[0], 1),
+                    ex => Assert.AreEqual("jsQueueThread", ex.ParamName));
+
+                AssertEx.Throws<ArgumentNullException>(
+                    () => new JavaScriptMemoryGovernor(thread, null, 1),
+                    ex => Assert.AreEqual("modules", ex.ParamName));
+
+                AssertEx.Throws<ArgumentOutOfRangeException>(
+                    () => new JavaScriptMemoryGovernor(thread, new INativeModule[0], 0),
+                    ex => Assert.AreEqual("budget", ex.ParamName));
+            }
+        }
+
+        [TestMethod]
+        public async Task JavaScriptMemoryGovernor_TrimAsync()
+        {
+            var module = new TrimMemoryModule();
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var governor = new JavaScriptMemoryGovernor(thread, new[] { module }, 64 * 1024 * 1024))
+                {
+                    governor.Start();
+                    await governor.TrimAsync();
+
+                    Assert.AreEqual(1, module.TrimMemoryCount);
+                    Assert.AreEqual(1, governor.TrimCount);
+                    Assert.IsTrue(governor.CollectionCount >= 1);
+                    Assert.IsTrue(governor.PeakHeapSize >= governor.HeapSize);
+                }
+            }
+        }
+
+        [TestMethod]
+        public async Task JavaScriptMemoryGovernor_OverBudget()
+        {
+            var module = new TrimMemoryModule();
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var governor = new JavaScriptMemoryGovernor(thread, new[] { module }, 1024 * 1024))
+                {
+                    governor.Start();
+
+                    // The budget is not a hard limit, so the script still runs.
+                    Assert.AreEqual(100000.0, await thread.CallOnQueue(() => JavaScriptContext.RunScript("var a = []; for (var i = 0; i < 100000; ++i) { a.push({ i: i }); } a.length").ToDouble()));
+
+                    // The trim for the budget runs in the idle lane, ahead of this.
+                    var idle = new TaskCompletionSource<bool>();
+                    thread.RunOnQueue(() => idle.SetResult(true), MessageQueuePriority.Idle);
+                    await idle.Task;
+
+                    Assert.IsTrue(governor.TrimCount >= 1);
+                    Assert.IsTrue(module.TrimMemoryCount >= 1);
+                    Assert.IsTrue(governor.PeakHeapSize > 1024 * 1024);
+                }
+            }
+        }
+
+        class TrimMemoryModule : NativeModuleBase, IOnTrimMemoryListener
+        {
+            public int TrimMemoryCount { get; private set; }
+
+            public override string Name
+            {
+                get
+                {
+                    return "Test";
+                }
+            }
+
+            public void OnTrimMemory()
+            {
+                TrimMemoryCount++;
+            }
+        }
+    }
+}
@@ -0,0 +1,151 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using ReactNative.Bridge;
+using ReactNative.Bridge.Queue;
+using ReactNative.Hosting;
+using System;
+using System.Runtime.InteropServices;
+using System.Threading.Tasks;
+
+namespace ReactNative.Tests.Bridge
+{
+    [TestClass]
+    public class NativeBufferTests
+    {
+        private const string BatchedBridgeScript =
+            "var received = null;" +
+            "var __fbBatchedBridge = {" +
+            "  callFunctionReturnFlushedQueue: function () { return null; }," +
+            "  invokeCallbackAndReturnFlushedQueue: function (id, args) { received = args[0]; return [[0], [0], [[received]]]; }" +
+            "};";
+
+        [TestMethod]
+        public void NativeBuffer_ArgumentChecks()
+        {
+            AssertEx.Throws<ArgumentOutOfRangeException>(
+                () => NativeBuffer.Allocate(-1),
+                ex => Assert.AreEqual("length", ex.ParamName));
+
+            AssertEx.Throws<ArgumentNullException>(
+                () => NativeBuffer.Pin(null),
+                ex => Assert.AreEqual("bytes", ex.ParamName));
+        }
+
+        [TestMethod]
+        public void NativeBuffer_Dispose()
+        {
+            var buffer = NativeBuffer.Allocate(16);
+            Assert.AreEqual(16, buffer.Length);
+            Assert.AreNotEqual(IntPtr.Zero, buffer.Data);
+
+            buffer.Dispose();
+            buffer.Dispose();
+            AssertEx.Throws<ObjectDisposedException>(() => { var data = buffer.Data; });
+        }
+
+        [TestMethod]
+        public async Task NativeBuffer_RoundTrip()
+        {
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var pool = new JavaScriptInstancePool(thread, new TestBundleLoader(BatchedBridgeScript), 1))
+                {
+                    var callback = new RecordingReactCallback();
+                    using (var instance = await pool.AcquireAsync(callback))
+                    {
+                        var buffer = NativeBuffer.Allocate(4);
+                        Marshal.Copy(new byte[] { 1, 2, 3, 4 }, 0, buffer.Data, 4);
+
+                        await instance.JSQueueThread.CallOnQueue(() =>
+                        {
+                            instance.Bridge.InvokeCallback(1, new object[] { buffer });
+                            return true;
+                        });
+
+                        // The ArrayBuffer keeps the memory alive after the native owner lets go.
+                        buffer.Dispose();
+
+                        Assert.AreEqual(4.0, await instance.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("received.byteLength").ToDouble()));
+                        Assert.AreEqual(3.0, await instance.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("new Uint8Array(received)[2]").ToDouble()));
+
+                        // The ArrayBuffer returned by the script becomes a byte token.
+                        var parameters = (JArray)((JArray)callback.Batch[2])[0];
+                        Assert.AreEqual(JTokenType.Bytes, parameters[0].Type);
+                        CollectionAssert.AreEqual(new byte[] { 1, 2, 3, 4 }, parameters[0].ToObject<byte[]>());
+                    }
+                }
+            }
+        }
+
+        [TestMethod]
+        public async Task NativeBuffer_BatchedCallback()
+        {
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var pool = new JavaScriptInstancePool(thread, new TestBundleLoader(BatchedBridgeScript), 1))
+                using (var instance = await pool.AcquireAsync(new RecordingReactCallback()))
+                {
+                    var module = new BufferModule();
+                    var registry = new NativeModuleRegistry.Builder()
+                        .Add(module)
+                        .Build();
+
+                    var catalystInstance = new MockCatalystInstance(
+                        (id, args) => instance.Bridge.InvokeCallback(id, args),
+                        (ids, argsList) => instance.Bridge.InvokeCallbacks(ids, argsList));
+
+                    // The module disposes of the buffer before the batch sends its callbacks.
+                    await instance.JSQueueThread.CallOnQueue(() =>
+                    {
+                        registry.InvokeBatch(catalystInstance, JArray.Parse("[[0],[0],[[1]]]"));
+                        return true;
+                    });
+
+                    Assert.IsTrue(module.Disposed);
+                    Assert.AreEqual(4.0, await instance.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("received.byteLength").ToDouble()));
+                    Assert.AreEqual(3.0, await instance.JSQueueThread.CallOnQueue(() => JavaScriptContext.RunScript("new Uint8Array(received)[2]").ToDouble()));
+                }
+            }
+        }
+
+        class BufferModule : NativeModuleBase
+        {
+            public bool Disposed { get; private set; }
+
+            public override string Name
+            {
+                get
+                {
+                    return "Buffer";
+                }
+            }
+
+            [ReactMethod]
+            public void Send(ICallback callback)
+            {
+                using (var buffer = NativeBuffer.Allocate(4))
+                {
+                    Marshal.Copy(new byte[] { 1, 2, 3, 4 }, 0, buffer.Data, 4);
+                    callback.Invoke(buffer);
+                }
+
+                Disposed = true;
+            }
+        }
+
+        class RecordingReactCallback : IReactCallback
+        {
+            public JArray Batch { get; private set; }
+
+            public void Invoke(JsonReader batch)
+            {
+                Batch = JArray.Load(batch);
+            }
+        }
+    }
+}
@@ -0,0 +1,107 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using ReactNative.Bridge;
+using System.IO;
+
+namespace ReactNative.Tests.Bridge
+{
+    [TestClass]
+    public class NativeModuleBaseBenchmarks
+    {
+        private const int OperationCount = 100000;
+
+        [TestMethod]
+        [TestCategory("Benchmark")]
+        public void NativeModuleBase_Benchmark_Invoke()
+        {
+            var module = new BenchmarkModule();
+            Run(module, "NoArgs", "[]");
+            Run(module, "Int32", "[42]");
+            Run(module, "Mixed", "[42, 0.5, true, \"foo\"]");
+            Run(module, "Object", "[{ \"foo\": 42, \"bar\": [1, 2, 3] }]");
+        }
+
+        [TestMethod]
+        [TestCategory("Benchmark")]
+        public void NativeModuleBase_Benchmark_Callback()
+        {
+            var module = new BenchmarkModule();
+            var count = 0;
+            var catalystInstance = new MockCatalystInstance((id, args) => count++);
+            var method = module.Methods["Callback"];
+            var arguments = JArray.Parse("[1]");
+
+            Benchmark.Run("NativeMethod.Invoke(Callback)", OperationCount, () =>
+            {
+                for (var i = 0; i < OperationCount; ++i)
+                {
+                    method.Invoke(catalystInstance, arguments);
+                }
+            });
+
+            Assert.AreNotEqual(0, count);
+        }
+
+        private static void Run(BenchmarkModule module, string methodName, string json)
+        {
+            var method = module.Methods[methodName];
+            var arguments = JArray.Parse(json);
+
+            Benchmark.Run("NativeMethod.Invoke(JArray) " + methodName, OperationCount, () =>
+            {
+                for (var i = 0; i < OperationCount; ++i)
+                {
+                    method.Invoke(null, arguments);
+                }
+            });
+
+            Benchmark.Run("NativeMethod.Invoke(JsonReader) " + methodName, OperationCount, () =>
+            {
+                for (var i = 0; i < OperationCount; ++i)
+                {
+                    var reader = new JsonTextReader(new StringReader(json));
+                    reader.Read();
+                    method.Invoke(null, reader);
+                }
+            });
+        }
+
+        class BenchmarkModule : NativeModuleBase
+        {
+            public override string Name
+            {
+                get
+                {
+                    return "Benchmark";
+                }
+            }
+
+            [ReactMethod]
+            public void NoArgs()
+            {
+            }
+
+            [ReactMethod]
+            public void Int32(int i)
+            {
+            }
+
+            [ReactMethod]
+            public void Mixed(int i, double d, bool b, string s)
+            {
+            }
+
+            [ReactMethod]
+            public void Object(JObject o)
+            {
+            }
+
+            [ReactMethod]
+            public void Callback(ICallback callback)
+            {
+                callback.Invoke(42);
+            }
+        }
+    }
+}
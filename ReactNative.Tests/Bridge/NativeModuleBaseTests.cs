@@ -1,11 +1,17 @@
 ﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Threading.Tasks;
 using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
 using ReactNative.Bridge;
+using ReactNative.Bridge.Queue;
 
 namespace ReactNative.Tests.Bridge
 {
     [TestClass]
-    public class NativeModuleBaseTests
+    public partial class NativeModuleBaseTests
     {
         [TestMethod]
         public void NativeModuleBase_ArgumentChecks()
@@ -13,8 +19,302 @@ namespace ReactNative.Tests.Bridge
 
         }
 
+        [TestMethod]
+        public void NativeModuleBase_Invoke_JsonReader()
+        {
+            var module = new TestNativeModule();
+            module.Initialize();
+
+            var reader = CreateReader("[42, 0.5, true, \"foo\", { \"bar\": 1 }]");
+            module.Methods["Echo"].Invoke(null, reader);
+
+            Assert.AreEqual(JsonToken.EndArray, reader.TokenType);
+            Assert.AreEqual(42, module.IntValue);
+            Assert.AreEqual(0.5, module.DoubleValue);
+            Assert.AreEqual(true, module.BoolValue);
+            Assert.AreEqual("foo", module.StringValue);
+            Assert.AreEqual(1, module.ObjectValue.Value<int>("bar"));
+        }
+
+        [TestMethod]
+        public async Task NativeModuleBase_Invoke_FromBridge()
+        {
+            const string script =
+                "var __fbBatchedBridge = {" +
+                "  callFunctionReturnFlushedQueue: function (module, method, args) {" +
+                "    return [[0, 0], args, [[42, 0.5, true, 'foo', { bar: 1, baz: undefined, qux: function () {} }], [new Uint8Array([1, 2]).buffer, new Int32Array([3, -4])]]];" +
+                "  }," +
+                "  invokeCallbackAndReturnFlushedQueue: function () { return null; }" +
+                "};";
+
+            var module = new TestNativeModule();
+            var registry = new NativeModuleRegistry.Builder()
+                .Add(module)
+                .Build();
+
+            var methods = registry.ModuleConfigs["Foo"]()["methods"];
+            var methodIds = new object[]
+            {
+                methods["Echo"].Value<int>("methodID"),
+                methods["EchoArrays"].Value<int>("methodID"),
+            };
+
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var pool = new JavaScriptInstancePool(thread, new TestBundleLoader(script), 0))
+                using (var instance = await pool.AcquireAsync(registry.CreateReactCallback(null)))
+                {
+                    await instance.JSQueueThread.CallOnQueue(() =>
+                    {
+                        instance.Bridge.CallFunction(0, 0, methodIds);
+                        return true;
+                    });
+                }
+            }
+
+            // The arguments are read from the script values, as parsed JSON would be.
+            Assert.AreEqual(42, module.IntValue);
+            Assert.AreEqual(0.5, module.DoubleValue);
+            Assert.AreEqual(true, module.BoolValue);
+            Assert.AreEqual("foo", module.StringValue);
+            Assert.AreEqual(1, module.ObjectValue.Count);
+            Assert.AreEqual(1, module.ObjectValue.Value<int>("bar"));
+            CollectionAssert.AreEqual(new byte[] { 1, 2 }, module.BytesValue);
+            CollectionAssert.AreEqual(new[] { 3, -4 }, module.IntArrayValue);
+        }
+
+        [TestMethod]
+        public void NativeModuleBase_Invoke_JsonReader_InvalidArgumentCount()
+        {
+            var module = new TestNativeModule();
+            module.Initialize();
+
+            AssertEx.Throws<ArgumentException>(
+                () => module.Methods["Echo"].Invoke(null, CreateReader("[42, 0.5, true]")));
+            AssertEx.Throws<ArgumentException>(
+                () => module.Methods["Echo"].Invoke(null, CreateReader("[42, 0.5, true, null, {}, 0]")));
+        }
+
+        [TestMethod]
+        public void NativeModuleBase_GeneratedMethods()
+        {
+            var module = new GeneratedNativeModule();
+            Assert.AreEqual(1, module.Methods.Count);
+            Assert.IsInstanceOfType(module.Methods["Add"], typeof(GeneratedNativeMethod));
+
+            module.Methods["Add"].Invoke(null, JArray.Parse("[1, 2]"));
+            Assert.AreEqual(3, module.Sum);
+
+            module.Methods["Add"].Invoke(null, CreateReader("[3, 4]"));
+            Assert.AreEqual(10, module.Sum);
+
+            AssertEx.Throws<ArgumentException>(
+                () => module.Methods["Add"].Invoke(null, JArray.Parse("[1]")));
+        }
+
+        [TestMethod]
+        public async Task NativeModuleBase_BuildGeneratedMethods()
+        {
+            // The table of the partial module is generated by ReactNative.Build.
+            var module = new PartialNativeModule();
+            Assert.AreEqual(3, module.Methods.Count);
+            Assert.IsInstanceOfType(module.Methods["Add"], typeof(GeneratedNativeMethod));
+            Assert.AreEqual("remote", module.Methods["Add"].Type);
+            Assert.AreEqual("remoteAsync", module.Methods["Multiply"].Type);
+
+            module.Methods["Add"].Invoke(null, JArray.Parse("[1, 2]"));
+            Assert.AreEqual(3, module.Sum);
+
+            module.Methods["Add"].Invoke(null, CreateReader("[3, 4]"));
+            Assert.AreEqual(10, module.Sum);
+
+            AssertEx.Throws<ArgumentException>(
+                () => module.Methods["Add"].Invoke(null, JArray.Parse("[1]")));
+
+            var callbacks = new List<Tuple<int, object[]>>();
+            var catalystInstance = new MockCatalystInstance((id, args) => callbacks.Add(Tuple.Create(id, args)));
+
+            module.Methods["Greet"].Invoke(catalystInstance, JArray.Parse("[\"foo\", 5]"));
+            module.Methods["Greet"].Invoke(catalystInstance, CreateReader("[\"bar\", 6]"));
+            Assert.AreEqual(2, callbacks.Count);
+            Assert.AreEqual(5, callbacks[0].Item1);
+            CollectionAssert.AreEqual(new object[] { "Hello, foo" }, callbacks[0].Item2);
+            Assert.AreEqual(6, callbacks[1].Item1);
+            CollectionAssert.AreEqual(new object[] { "Hello, bar" }, callbacks[1].Item2);
+
+            var resolved = new TaskCompletionSource<Tuple<int, object[]>>();
+            catalystInstance = new MockCatalystInstance((id, args) => resolved.SetResult(Tuple.Create(id, args)));
+
+            module.Methods["Multiply"].Invoke(catalystInstance, CreateReader("[3, 4, 10, 11]"));
+            var result = await resolved.Task;
+            Assert.AreEqual(10, result.Item1);
+            CollectionAssert.AreEqual(new object[] { 12 }, result.Item2);
+        }
+
+        [TestMethod]
+        public async Task NativeModuleBase_Invoke_Async()
+        {
+            var module = new AsyncNativeModule();
+            Assert.AreEqual("remoteAsync", module.Methods["Add"].Type);
+
+            var callbacks = new TaskCompletionSource<Tuple<int, object[]>>();
+            var catalystInstance = new MockCatalystInstance((id, args) => callbacks.SetResult(Tuple.Create(id, args)));
+
+            module.Methods["Add"].Invoke(catalystInstance, JArray.Parse("[1, 2, 10, 11]"));
+            Assert.IsFalse(callbacks.Task.IsCompleted);
+
+            module.Completion.SetResult(true);
+            var resolved = await callbacks.Task;
+            Assert.AreEqual(10, resolved.Item1);
+            CollectionAssert.AreEqual(new object[] { 3 }, resolved.Item2);
+        }
+
+        [TestMethod]
+        public async Task NativeModuleBase_Invoke_Async_Rejects()
+        {
+            var module = new AsyncNativeModule();
+
+            var callbacks = new TaskCompletionSource<Tuple<int, object[]>>();
+            var catalystInstance = new MockCatalystInstance((id, args) => callbacks.SetResult(Tuple.Create(id, args)));
+
+            module.Methods["Add"].Invoke(catalystInstance, CreateReader("[1, 2, 10, 11]"));
+            module.Completion.SetException(new InvalidOperationException("Foo"));
+
+            var rejected = await callbacks.Task;
+            Assert.AreEqual(11, rejected.Item1);
+            Assert.AreEqual("Foo", ((JObject)rejected.Item2[0]).Value<string>("message"));
+
+            AssertEx.Throws<ArgumentException>(
+                () => module.Methods["Add"].Invoke(catalystInstance, JArray.Parse("[1, 2]")));
+        }
+
+        private static JsonReader CreateReader(string json)
+        {
+            var reader = new JsonTextReader(new StringReader(json));
+            reader.Read();
+            return reader;
+        }
+
+        class AsyncNativeModule : NativeModuleBase
+        {
+            public TaskCompletionSource<bool> Completion { get; } = new TaskCompletionSource<bool>();
+
+            public override string Name
+            {
+                get
+                {
+                    return "Async";
+                }
+            }
+
+            [ReactMethod]
+            public async Task<int> Add(int x, int y)
+            {
+                await Completion.Task;
+                return x + y;
+            }
+        }
+
+        partial class PartialNativeModule : NativeModuleBase
+        {
+            public int Sum { get; private set; }
+
+            public override string Name
+            {
+                get
+                {
+                    return "Partial";
+                }
+            }
+
+            [ReactMethod]
+            public void Add(int x, int y)
+            {
+                Sum += x + y;
+            }
+
+            [ReactMethod]
+            public void Greet(string name, ICallback callback)
+            {
+                callback.Invoke("Hello, " + name);
+            }
+
+            [ReactMethod]
+            public Task<int> Multiply(int x, int y)
+            {
+                return Task.FromResult(x * y);
+            }
+        }
+
+        class GeneratedNativeModule : NativeModuleBase
+        {
+            public int Sum { get; private set; }
+
+            public override string Name
+            {
+                get
+                {
+                    return "Generated";
+                }
+            }
+
+            [ReactMethod]
+            public void Add(int x, int y)
+            {
+                Sum += x + y;
+            }
+
+            [ReactMethod]
+            public void NotGenerated()
+            {
+            }
+
+            protected override IReadOnlyDictionary<string, INativeMethod> CreateGeneratedMethods()
+            {
+                // Mirrors the shape of the build-time generated table.
+                return new Dictionary<string, INativeMethod>
+                {
+                    {
+                        "Add",
+                        new GeneratedNativeMethod(
+                            "remote",
+                            (catalystInstance, arguments) =>
+                            {
+                                NativeArguments.CheckArgumentCount(arguments, 2);
+                                Add(
+                                    NativeArguments.Extract<int>(arguments[0]),
+                                    NativeArguments.Extract<int>(arguments[1]));
+                            },
+                            (catalystInstance, reader) =>
+                            {
+                                var x = NativeArguments.ReadInt32(reader);
+                                var y = NativeArguments.ReadInt32(reader);
+                                NativeArguments.ReadEndArray(reader);
+                                Add(x, y);
+                            })
+                    },
+                };
+            }
+        }
+
         class TestNativeModule : NativeModuleBase
         {
+            public int IntValue { get; private set; }
+
+            public double DoubleValue { get; private set; }
+
+            public bool BoolValue { get; private set; }
+
+            public string StringValue { get; private set; }
+
+            public JObject ObjectValue { get; private set; }
+
+            public byte[] BytesValue { get; private set; }
+
+            public int[] IntArrayValue { get; private set; }
+
             public override string Name
             {
                 get
@@ -22,6 +322,23 @@ namespace ReactNative.Tests.Bridge
                     return "Foo";
                 }
             }
+
+            [ReactMethod]
+            public void Echo(int i, double d, bool b, string s, JObject o)
+            {
+                IntValue = i;
+                DoubleValue = d;
+                BoolValue = b;
+                StringValue = s;
+                ObjectValue = o;
+            }
+
+            [ReactMethod]
+            public void EchoArrays(byte[] bytes, int[] values)
+            {
+                BytesValue = bytes;
+                IntArrayValue = values;
+            }
         }
     }
 }
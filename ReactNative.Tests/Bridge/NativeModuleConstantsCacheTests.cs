@@ -0,0 +1,63 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using Newtonsoft.Json.Linq;
+using ReactNative.Bridge;
+using System;
+using System.Threading.Tasks;
+using Windows.Storage;
+
+namespace ReactNative.Tests.Bridge
+{
+    [TestClass]
+    public class NativeModuleConstantsCacheTests
+    {
+        [TestMethod]
+        public void NativeModuleConstantsCache_ArgumentChecks()
+        {
+            AssertEx.Throws<ArgumentNullException>(
+                () => new NativeModuleConstantsCache(null),
+                ex => Assert.AreEqual("version", ex.ParamName));
+
+            var cache = new NativeModuleConstantsCache("1.0.0.0");
+            var constants = default(JObject);
+            AssertEx.Throws<ArgumentNullException>(
+                () => cache.TryGetConstants(null, out constants),
+                ex => Assert.AreEqual("moduleName", ex.ParamName));
+
+            AssertEx.Throws<ArgumentNullException>(
+                () => cache.SetConstants("Test", null),
+                ex => Assert.AreEqual("constants", ex.ParamName));
+        }
+
+        [TestMethod]
+        public async Task NativeModuleConstantsCache_SaveAsync()
+        {
+            var cache = new NativeModuleConstantsCache("test");
+            cache.SetConstants("Test", new JObject { { "Answer", 42 } });
+            await cache.SaveAsync();
+
+            var constants = default(JObject);
+            var loaded = await NativeModuleConstantsCache.LoadAsync("test");
+            Assert.IsTrue(loaded.TryGetConstants("Test", out constants));
+            Assert.AreEqual(42, constants.Value<int>("Answer"));
+
+            // Constants from another version are discarded.
+            var other = await NativeModuleConstantsCache.LoadAsync("other");
+            Assert.AreEqual("other", other.Version);
+            Assert.IsFalse(other.TryGetConstants("Test", out constants));
+        }
+
+        [TestMethod]
+        public async Task NativeModuleConstantsCache_LoadAsync_InvalidUtf8()
+        {
+            var folder = await ApplicationData.Current.LocalCacheFolder.CreateFolderAsync("ReactNative", CreationCollisionOption.OpenIfExists);
+            var file = await folder.CreateFileAsync("constants.json", CreationCollisionOption.ReplaceExisting);
+            await FileIO.WriteBytesAsync(file, new byte[] { 0x7B, 0xC3, 0x28, 0x7D });
+
+            // An unreadable cache is treated as empty.
+            var constants = default(JObject);
+            var loaded = await NativeModuleConstantsCache.LoadAsync("test");
+            Assert.AreEqual("test", loaded.Version);
+            Assert.IsFalse(loaded.TryGetConstants("Test", out constants));
+        }
+    }
+}
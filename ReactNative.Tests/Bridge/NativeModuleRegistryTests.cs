@@ -1,7 +1,12 @@
 ﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
 using ReactNative.Bridge;
+using ReactNative.Bridge.Queue;
 using System;
 using System.Collections.Generic;
+using System.IO;
+using System.Threading.Tasks;
 
 namespace ReactNative.Tests.Bridge
 {
@@ -44,6 +49,449 @@ namespace ReactNative.Tests.Bridge
                 ex => Assert.AreEqual("module", ex.ParamName));
         }
 
+        [TestMethod]
+        public void NativeModuleRegistry_Build_DefersModuleInitialization()
+        {
+            var module = new LazyModule();
+            var registry = new NativeModuleRegistry.Builder()
+                .Add(module)
+                .Build();
+
+            Assert.AreEqual(0, module.CreateConstantsCount);
+
+            registry.InvokeBatch(null, JArray.Parse("[[0],[0],[[]]]"));
+            Assert.AreEqual(1, module.CallCount);
+            Assert.AreEqual(0, module.CreateConstantsCount);
+
+            Assert.AreEqual(42, module.Constants["Answer"]);
+            Assert.AreEqual(42, module.Constants["Answer"]);
+            Assert.AreEqual(1, module.CreateConstantsCount);
+        }
+
+        [TestMethod]
+        public void NativeModuleRegistry_ModuleConfigs()
+        {
+            var module = new LazyModule();
+            var registry = new NativeModuleRegistry.Builder()
+                .Add(new BatchModule())
+                .Add(module)
+                .Build();
+
+            Assert.AreEqual(2, registry.ModuleConfigs.Count);
+            Assert.AreEqual(0, module.CreateConstantsCount);
+
+            var config = registry.ModuleConfigs["Lazy"]();
+            Assert.AreEqual(1, config.Value<int>("moduleID"));
+            Assert.AreEqual(0, config["methods"]["Call"].Value<int>("methodID"));
+            Assert.AreEqual("remote", config["methods"]["Call"].Value<string>("type"));
+            Assert.AreEqual(42, config["constants"].Value<int>("Answer"));
+
+            Assert.AreSame(config, registry.ModuleConfigs["Lazy"]());
+            Assert.AreEqual(1, module.CreateConstantsCount);
+        }
+
+        [TestMethod]
+        public void NativeModuleRegistry_ModuleConfigs_ConstantsCache()
+        {
+            var cache = new NativeModuleConstantsCache("1.0.0.0");
+            var stableModule = new StableModule();
+            var lazyModule = new LazyModule();
+            var registry = new NativeModuleRegistry.Builder()
+                .SetConstantsCache(cache)
+                .Add(stableModule)
+                .Add(lazyModule)
+                .Build();
+
+            Assert.AreEqual(42, registry.ModuleConfigs["Stable"]()["constants"].Value<int>("Answer"));
+            Assert.AreEqual(42, registry.ModuleConfigs["Lazy"]()["constants"].Value<int>("Answer"));
+
+            var constants = default(JObject);
+            Assert.IsTrue(cache.TryGetConstants("Stable", out constants));
+            Assert.IsFalse(cache.TryGetConstants("Lazy", out constants));
+
+            // The next start is configured from the cache.
+            var nextModule = new StableModule();
+            var nextRegistry = new NativeModuleRegistry.Builder()
+                .SetConstantsCache(cache)
+                .Add(nextModule)
+                .Build();
+
+            Assert.AreEqual(42, nextRegistry.ModuleConfigs["Stable"]()["constants"].Value<int>("Answer"));
+            Assert.AreEqual(1, stableModule.CreateConstantsCount);
+            Assert.AreEqual(0, nextModule.CreateConstantsCount);
+        }
+
+        [TestMethod]
+        public async Task NativeModuleRegistry_InvokeBatch_ActionQueue()
+        {
+            using (var actionQueue = MessageQueueThread.Create(MessageQueueThreadSpec.Create("test"), new ThrowingExceptionHandler()))
+            {
+                var queuedModule = new QueuedBatchModule(actionQueue);
+                var module = new BatchModule();
+                var registry = new NativeModuleRegistry.Builder()
+                    .Add(queuedModule)
+                    .Add(module)
+                    .Build();
+
+                registry.InvokeBatch(null, JArray.Parse("[[0,1,0],[0,0,0],[[1],[2],[3]]]"));
+                registry.InvokeBatch(null, new JsonTextReader(new StringReader("[[0,1],[0,0],[[4],[5]]]")));
+                Assert.AreEqual(7, module.Sum);
+                Assert.AreEqual(2, module.BatchCompleteCount);
+
+                actionQueue.Start();
+                var result = await actionQueue.CallOnQueue(() => Tuple.Create(queuedModule.Sum, queuedModule.BatchCompleteCount, queuedModule.RanOnQueue));
+                Assert.AreEqual(8, result.Item1);
+                Assert.AreEqual(2, result.Item2);
+                Assert.IsTrue(result.Item3);
+            }
+        }
+
+        [TestMethod]
+        public void NativeModuleRegistry_InvokeBatch_ArgumentChecks()
+        {
+            var registry = new NativeModuleRegistry.Builder().Build();
+            AssertEx.Throws<ArgumentNullException>(
+                () => registry.InvokeBatch(null, null),
+                ex => Assert.AreEqual("batch", ex.ParamName));
+            AssertEx.Throws<ArgumentException>(
+                () => registry.InvokeBatch(null, JArray.Parse("[[0],[0]]")),
+                ex => Assert.AreEqual("batch", ex.ParamName));
+            AssertEx.Throws<ArgumentException>(
+                () => registry.InvokeBatch(null, JArray.Parse("[[0],[0,0],[[]]]")),
+                ex => Assert.AreEqual("batch", ex.ParamName));
+        }
+
+        [TestMethod]
+        public void NativeModuleRegistry_InvokeBatch_CompletesOnce()
+        {
+            var module = new BatchModule();
+            module.Initialize();
+
+            var registry = new NativeModuleRegistry.Builder()
+                .Add(module)
+                .Build();
+
+            registry.InvokeBatch(null, JArray.Parse("[[0,0,0],[0,0,0],[[1],[2],[3]]]"));
+            Assert.AreEqual(6, module.Sum);
+            Assert.AreEqual(1, module.BatchCompleteCount);
+
+            registry.InvokeBatch(null, JArray.Parse("[[],[],[]]"));
+            Assert.AreEqual(2, module.BatchCompleteCount);
+        }
+
+        [TestMethod]
+        public void NativeModuleRegistry_InvokeBatch_JsonReader()
+        {
+            var module = new BatchModule();
+            module.Initialize();
+
+            var registry = new NativeModuleRegistry.Builder()
+                .Add(module)
+                .Build();
+
+            var reader = new JsonTextReader(new StringReader("[[0,0],[0,0],[[1],[2]],7]"));
+            registry.InvokeBatch(null, reader);
+            Assert.AreEqual(3, module.Sum);
+            Assert.AreEqual(1, module.BatchCompleteCount);
+
+            AssertEx.Throws<ArgumentException>(
+                () => registry.InvokeBatch(null, new JsonTextReader(new StringReader("[[0],[0,0],[[1]]]"))),
+                ex => Assert.AreEqual("reader", ex.ParamName));
+        }
+
+        [TestMethod]
+        public void NativeModuleRegistry_InvokeBatch_Throws()
+        {
+            var module = new FailingModule();
+            var registry = new NativeModuleRegistry.Builder()
+                .Add(module)
+                .Build();
+
+            AssertEx.Throws<InvalidOperationException>(() => registry.InvokeBatch(null, JArray.Parse("[[0],[0],[[]]]")));
+            Assert.AreEqual(1, module.BatchCompleteCount);
+
+            AssertEx.Throws<InvalidOperationException>(() => registry.InvokeBatch(null, new JsonTextReader(new StringReader("[[0],[0],[[]]]"))));
+            Assert.AreEqual(2, module.BatchCompleteCount);
+        }
+
+        [TestMethod]
+        public void NativeModuleRegistry_InvokeBatch_Nested()
+        {
+            var reentrantModule = new ReentrantModule();
+            var batchModule = new BatchModule();
+            var registry = new NativeModuleRegistry.Builder()
+                .Add(reentrantModule)
+                .Add(batchModule)
+                .Build();
+
+            // The nested batch must not disturb the IDs of the outer one.
+            reentrantModule.Registry = registry;
+            registry.InvokeBatch(null, new JsonTextReader(new StringReader("[[0,1],[0,0],[[],[10]]]")));
+            Assert.AreEqual(15, batchModule.Sum);
+            Assert.AreEqual(2, batchModule.BatchCompleteCount);
+        }
+
+        [TestMethod]
+        public void NativeModuleRegistry_InvokeBatch_BatchesCallbacks()
+        {
+            var registry = new NativeModuleRegistry.Builder()
+                .Add(new CallbackModule())
+                .Build();
+
+            var singleCallbacks = new List<int>();
+            var batchedCallbacks = new List<IList<int>>();
+            var catalystInstance = new MockCatalystInstance(
+                (id, args) => singleCallbacks.Add(id),
+                (ids, argsList) => batchedCallbacks.Add(new List<int>(ids)));
+
+            registry.InvokeBatch(catalystInstance, JArray.Parse("[[0,0,0],[0,0,0],[[1],[2],[3]]]"));
+            Assert.AreEqual(0, singleCallbacks.Count);
+            Assert.AreEqual(1, batchedCallbacks.Count);
+            CollectionAssert.AreEqual(new[] { 1, 2, 3 }, (List<int>)batchedCallbacks[0]);
+
+            registry.InvokeBatch(catalystInstance, new JsonTextReader(new StringReader("[[0,0],[0,0],[[4],[5]]]")));
+            Assert.AreEqual(2, batchedCallbacks.Count);
+            CollectionAssert.AreEqual(new[] { 4, 5 }, (List<int>)batchedCallbacks[1]);
+
+            // Outside of a batch, callbacks are sent right away.
+            registry.Invoke(catalystInstance, 0, 0, JArray.Parse("[6]"));
+            CollectionAssert.AreEqual(new[] { 6 }, singleCallbacks);
+        }
+
+        [TestMethod]
+        public async Task NativeModuleRegistry_InvokeBatch_FromBridge()
+        {
+            const string script =
+                "var __fbBatchedBridge = {" +
+                "  callFunctionReturnFlushedQueue: function (module, method, args) { return [[0, 1], [0, 0], [[args[0]], [1]], 7]; }," +
+                "  invokeCallbackAndReturnFlushedQueue: function () { return null; }" +
+                "};";
+
+            var module = new BatchModule();
+            var registry = new NativeModuleRegistry.Builder()
+                .Add(module)
+                .Add(new CallbackModule())
+                .Build();
+
+            var callbackIds = new List<int>();
+            var catalystInstance = new MockCatalystInstance(
+                (id, args) => callbackIds.Add(id),
+                (ids, argsList) => callbackIds.AddRange(ids));
+
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var pool = new JavaScriptInstancePool(thread, new TestBundleLoader(script), 0))
+                using (var instance = await pool.AcquireAsync(registry.CreateReactCallback(catalystInstance)))
+                {
+                    await instance.JSQueueThread.CallOnQueue(() =>
+                    {
+                        instance.Bridge.CallFunction(0, 0, new object[] { 2 });
+                        instance.Bridge.CallFunctions(0, 0, new List<object[]> { new object[] { 3 }, new object[] { 4 } });
+                        return true;
+                    });
+                }
+            }
+
+            // The queues flushed by CallFunctions are invoked as one batch.
+            Assert.AreEqual(9, module.Sum);
+            Assert.AreEqual(2, module.BatchCompleteCount);
+            CollectionAssert.AreEqual(new[] { 1, 1, 1 }, callbackIds);
+        }
+
+        class CallbackModule : NativeModuleBase
+        {
+            public override string Name
+            {
+                get
+                {
+                    return "Callback";
+                }
+            }
+
+            [ReactMethod]
+            public void Call(ICallback callback)
+            {
+                callback.Invoke(42);
+            }
+        }
+
+        class FailingModule : NativeModuleBase, IOnBatchCompleteListener
+        {
+            public int BatchCompleteCount { get; private set; }
+
+            public override string Name
+            {
+                get
+                {
+                    return "Failing";
+                }
+            }
+
+            [ReactMethod]
+            public void Fail()
+            {
+                throw new InvalidOperationException();
+            }
+
+            public void OnBatchComplete()
+            {
+                BatchCompleteCount++;
+            }
+        }
+
+        class ReentrantModule : NativeModuleBase
+        {
+            public NativeModuleRegistry Registry { get; set; }
+
+            public override string Name
+            {
+                get
+                {
+                    return "Reentrant";
+                }
+            }
+
+            [ReactMethod]
+            public void Nest()
+            {
+                Registry.InvokeBatch(null, new JsonTextReader(new StringReader("[[1],[0],[[5]]]")));
+            }
+        }
+
+        class BatchModule : NativeModuleBase, IOnBatchCompleteListener
+        {
+            public int Sum { get; private set; }
+
+            public int BatchCompleteCount { get; private set; }
+
+            public override string Name
+            {
+                get
+                {
+                    return "Batch";
+                }
+            }
+
+            [ReactMethod]
+            public void Add(int value)
+            {
+                Sum += value;
+            }
+
+            public void OnBatchComplete()
+            {
+                BatchCompleteCount++;
+            }
+        }
+
+        class QueuedBatchModule : NativeModuleBase, IOnBatchCompleteListener
+        {
+            private readonly IMessageQueueThread _actionQueue;
+
+            public QueuedBatchModule(IMessageQueueThread actionQueue)
+            {
+                _actionQueue = actionQueue;
+                RanOnQueue = true;
+            }
+
+            public int Sum { get; private set; }
+
+            public int BatchCompleteCount { get; private set; }
+
+            public bool RanOnQueue { get; private set; }
+
+            public override IMessageQueueThread ActionQueue
+            {
+                get
+                {
+                    return _actionQueue;
+                }
+            }
+
+            public override string Name
+            {
+                get
+                {
+                    return "QueuedBatch";
+                }
+            }
+
+            [ReactMethod]
+            public void Add(int value)
+            {
+                RanOnQueue &= _actionQueue.IsOnThread();
+                Sum += value;
+            }
+
+            public void OnBatchComplete()
+            {
+                RanOnQueue &= _actionQueue.IsOnThread();
+                BatchCompleteCount++;
+            }
+        }
+
+        class LazyModule : NativeModuleBase
+        {
+            public int CallCount { get; private set; }
+
+            public int CreateConstantsCount { get; private set; }
+
+            public override string Name
+            {
+                get
+                {
+                    return "Lazy";
+                }
+            }
+
+            [ReactMethod]
+            public void Call()
+            {
+                CallCount++;
+            }
+
+            protected override IReadOnlyDictionary<string, object> CreateConstants()
+            {
+                CreateConstantsCount++;
+                return new Dictionary<string, object>
+                {
+                    { "Answer", 42 },
+                };
+            }
+        }
+
+        class StableModule : NativeModuleBase
+        {
+            public int CreateConstantsCount { get; private set; }
+
+            public override bool HasStableConstants
+            {
+                get
+                {
+                    return true;
+                }
+            }
+
+            public override string Name
+            {
+                get
+                {
+                    return "Stable";
+                }
+            }
+
+            protected override IReadOnlyDictionary<string, object> CreateConstants()
+            {
+                CreateConstantsCount++;
+                return new Dictionary<string, object>
+                {
+                    { "Answer", 42 },
+                };
+            }
+        }
+
         class OverrideDisallowedModule : NativeModuleBase
         {
             public override string Name
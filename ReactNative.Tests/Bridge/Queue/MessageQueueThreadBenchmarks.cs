@@ -0,0 +1,124 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using ReactNative.Bridge.Queue;
+using System;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace ReactNative.Tests.Bridge.Queue
+{
+    [TestClass]
+    public class MessageQueueThreadBenchmarks
+    {
+        private const int OperationCount = 100000;
+        private const int LatencyOperationCount = 1000;
+        private const int ProducerCount = 4;
+
+        [TestMethod]
+        [TestCategory("Benchmark")]
+        public async Task MessageQueueThread_Benchmark_Throughput()
+        {
+            using (var thread = CreateThread())
+            {
+                thread.Start();
+
+                await Benchmark.Run("MessageQueueThread.RunOnQueue", OperationCount, () =>
+                {
+                    var remaining = OperationCount;
+                    var done = new TaskCompletionSource<bool>();
+                    Action action = () =>
+                    {
+                        if (--remaining == 0)
+                        {
+                            done.SetResult(true);
+                        }
+                    };
+
+                    for (var i = 0; i < OperationCount; ++i)
+                    {
+                        thread.RunOnQueue(action);
+                    }
+
+                    return done.Task;
+                });
+            }
+        }
+
+        [TestMethod]
+        [TestCategory("Benchmark")]
+        public async Task MessageQueueThread_Benchmark_Contention()
+        {
+            using (var thread = CreateThread())
+            {
+                thread.Start();
+
+                await Benchmark.Run("MessageQueueThread.RunOnQueue x" + ProducerCount, OperationCount, () =>
+                {
+                    var remaining = OperationCount;
+                    var done = new TaskCompletionSource<bool>();
+                    Action action = () =>
+                    {
+                        if (--remaining == 0)
+                        {
+                            done.SetResult(true);
+                        }
+                    };
+
+                    var producers = new Task[ProducerCount];
+                    for (var i = 0; i < ProducerCount; ++i)
+                    {
+                        producers[i] = Task.Run(() =>
+                        {
+                            for (var j = 0; j < OperationCount / ProducerCount; ++j)
+                            {
+                                thread.RunOnQueue(action);
+                            }
+                        });
+                    }
+
+                    return Task.WhenAll(producers).ContinueWith(_ => done.Task).Unwrap();
+                });
+            }
+        }
+
+        [TestMethod]
+        [TestCategory("Benchmark")]
+        public async Task MessageQueueThread_Benchmark_Latency()
+        {
+            using (var thread = CreateThread())
+            using (var cancellationTokenSource = new CancellationTokenSource())
+            {
+                thread.Start();
+
+                // Keep the queue busy from other threads while measuring.
+                var token = cancellationTokenSource.Token;
+                var producers = new Task[ProducerCount];
+                for (var i = 0; i < ProducerCount; ++i)
+                {
+                    producers[i] = Task.Run(async () =>
+                    {
+                        while (!token.IsCancellationRequested)
+                        {
+                            await thread.CallOnQueue(() => true);
+                        }
+                    });
+                }
+
+                await Benchmark.Run("MessageQueueThread.CallOnQueue (contended)", LatencyOperationCount, async () =>
+                {
+                    for (var i = 0; i < LatencyOperationCount; ++i)
+                    {
+                        await thread.CallOnQueue(() => i);
+                    }
+                });
+
+                cancellationTokenSource.Cancel();
+                await Task.WhenAll(producers);
+            }
+        }
+
+        private static MessageQueueThread CreateThread()
+        {
+            return MessageQueueThread.Create(MessageQueueThreadSpec.Create("benchmark"), new ThrowingExceptionHandler());
+        }
+    }
+}
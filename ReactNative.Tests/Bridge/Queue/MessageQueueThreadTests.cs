@@ -0,0 +1,214 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using ReactNative.Bridge.Queue;
+using ReactNative.Hosting;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace ReactNative.Tests.Bridge.Queue
+{
+    [TestClass]
+    public class MessageQueueThreadTests
+    {
+        [TestMethod]
+        public void MessageQueueThread_ArgumentChecks()
+        {
+            AssertEx.Throws<ArgumentNullException>(
+                () => MessageQueueThread.Create(null, new ThrowingExceptionHandler()),
+                ex => Assert.AreEqual("spec", ex.ParamName));
+
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.Create("test"), new ThrowingExceptionHandler()))
+            {
+                AssertEx.Throws<ArgumentNullException>(
+                    () => thread.RunOnQueue(null),
+                    ex => Assert.AreEqual("action", ex.ParamName));
+            }
+        }
+
+        [TestMethod]
+        public async Task MessageQueueThread_CallOnQueue()
+        {
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.Create("test"), new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+                Assert.IsTrue(await thread.CallOnQueue(() => thread.IsOnThread()));
+                Assert.IsFalse(thread.IsOnThread());
+            }
+        }
+
+        [TestMethod]
+        public async Task MessageQueueThread_CallOnQueue_OnThread()
+        {
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.Create("test"), new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                var isCompleted = await thread.CallOnQueue(() => thread.CallOnQueue(() => 42).IsCompleted);
+                Assert.IsTrue(isCompleted);
+
+                var exception = await thread.CallOnQueue(() => thread.CallOnQueue<int>(() => { throw new InvalidOperationException(); }).Exception);
+                Assert.IsInstanceOfType(exception.InnerException, typeof(InvalidOperationException));
+            }
+        }
+
+        [TestMethod]
+        public async Task MessageQueueThread_Priority()
+        {
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.Create("test"), new ThrowingExceptionHandler()))
+            {
+                var order = new List<MessageQueuePriority>();
+                thread.RunOnQueue(() => order.Add(MessageQueuePriority.Idle), MessageQueuePriority.Idle);
+                thread.RunOnQueue(() => order.Add(MessageQueuePriority.Normal));
+                thread.RunOnQueue(() => order.Add(MessageQueuePriority.UserBlocking), MessageQueuePriority.UserBlocking);
+                thread.RunOnQueue(() => order.Add(MessageQueuePriority.Immediate), MessageQueuePriority.Immediate);
+
+                var done = new TaskCompletionSource<bool>();
+                thread.RunOnQueue(() => done.SetResult(true), MessageQueuePriority.Idle);
+
+                thread.Start();
+                await done.Task;
+
+                CollectionAssert.AreEqual(
+                    new[]
+                    {
+                        MessageQueuePriority.Immediate,
+                        MessageQueuePriority.UserBlocking,
+                        MessageQueuePriority.Normal,
+                        MessageQueuePriority.Idle,
+                    },
+                    order);
+            }
+        }
+
+        [TestMethod]
+        public async Task MessageQueueThread_Background_Dispose()
+        {
+            await AssertDisposeFaultsPendingWorkAsync(MessageQueueThreadSpec.Create("test"));
+        }
+
+        [TestMethod]
+        public async Task MessageQueueThread_JavaScript_Dispose()
+        {
+            await AssertDisposeFaultsPendingWorkAsync(MessageQueueThreadSpec.CreateJavaScript("test", Timeout.InfiniteTimeSpan));
+        }
+
+        [TestMethod]
+        public async Task MessageQueueThread_Background_Serial()
+        {
+            const int QueueCount = 64;
+            const int ActionCount = 100;
+
+            var threads = Enumerable.Range(0, QueueCount)
+                .Select(i => MessageQueueThread.Create(MessageQueueThreadSpec.Create("test" + i), new ThrowingExceptionHandler()))
+                .ToList();
+
+            try
+            {
+                var orders = threads.Select(_ => new List<int>()).ToList();
+                var running = new int[QueueCount];
+                var overlapped = false;
+                var offThread = false;
+
+                foreach (var thread in threads)
+                {
+                    thread.Start();
+                }
+
+                for (var i = 0; i < ActionCount; ++i)
+                {
+                    for (var j = 0; j < QueueCount; ++j)
+                    {
+                        var queue = j;
+                        var value = i;
+                        threads[queue].RunOnQueue(() =>
+                        {
+                            if (Interlocked.Increment(ref running[queue]) != 1)
+                            {
+                                overlapped = true;
+                            }
+
+                            if (!threads[queue].IsOnThread() || threads[(queue + 1) % QueueCount].IsOnThread())
+                            {
+                                offThread = true;
+                            }
+
+                            orders[queue].Add(value);
+                            Interlocked.Decrement(ref running[queue]);
+                        });
+                    }
+                }
+
+                await Task.WhenAll(threads.Select(thread => thread.CallOnQueue(() => true)));
+
+                Assert.IsFalse(overlapped);
+                Assert.IsFalse(offThread);
+                foreach (var order in orders)
+                {
+                    CollectionAssert.AreEqual(Enumerable.Range(0, ActionCount).ToList(), order);
+                }
+            }
+            finally
+            {
+                foreach (var thread in threads)
+                {
+                    thread.Dispose();
+                }
+            }
+        }
+
+        [TestMethod]
+        public async Task MessageQueueThread_JavaScript_Watchdog()
+        {
+            var spec = MessageQueueThreadSpec.CreateJavaScript("js", TimeSpan.FromMilliseconds(100));
+            using (var thread = MessageQueueThread.Create(spec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                var exception = default(JavaScriptScriptException);
+                try
+                {
+                    await thread.CallOnQueue(() => JavaScriptContext.RunScript("while (true) {}"));
+                }
+                catch (JavaScriptScriptException ex)
+                {
+                    exception = ex;
+                }
+
+                Assert.IsNotNull(exception);
+                Assert.AreEqual(JavaScriptErrorCode.ScriptTerminated, exception.ErrorCode);
+                StringAssert.Contains(exception.Message, "Script on thread 'js' was interrupted by the watchdog");
+
+                // The runtime is usable again after the interrupt.
+                Assert.AreEqual(2.0, await thread.CallOnQueue(() => JavaScriptContext.RunScript("1 + 1").ToDouble()));
+            }
+        }
+
+        private static async Task AssertDisposeFaultsPendingWorkAsync(MessageQueueThreadSpec spec)
+        {
+            var thread = MessageQueueThread.Create(spec, new ThrowingExceptionHandler());
+
+            // The thread is not started, so the work is still queued when it is disposed.
+            var pending = thread.CallOnQueue(() => 42);
+            thread.Dispose();
+            var late = thread.CallOnQueue(() => 42);
+
+            foreach (var task in new[] { pending, late })
+            {
+                var exception = default(ObjectDisposedException);
+                try
+                {
+                    await task;
+                }
+                catch (ObjectDisposedException ex)
+                {
+                    exception = ex;
+                }
+
+                Assert.IsNotNull(exception);
+                Assert.AreEqual("test", exception.ObjectName);
+            }
+        }
+    }
+}
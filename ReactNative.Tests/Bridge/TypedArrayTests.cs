@@ -0,0 +1,164 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using ReactNative.Bridge;
+using ReactNative.Bridge.Queue;
+using ReactNative.Hosting;
+using System;
+using System.Threading.Tasks;
+
+namespace ReactNative.Tests.Bridge
+{
+    [TestClass]
+    public class TypedArrayTests
+    {
+        private const string BatchedBridgeScript =
+            "var received = null;" +
+            "var __fbBatchedBridge = {" +
+            "  callFunctionReturnFlushedQueue: function () {" +
+            "    return [[0], [0], [[new Int8Array([-1, 127, -128]), new Uint32Array([4294967295, 1]), new Int16Array([-2]), new Uint16Array([65535])]]];" +
+            "  }," +
+            "  invokeCallbackAndReturnFlushedQueue: function (id, args) { received = args[0]; return [[0], [0], [[received]]]; }" +
+            "};";
+
+        [TestMethod]
+        public void TypedArray_ArgumentChecks()
+        {
+            AssertEx.Throws<ArgumentNullException>(
+                () => new TypedArray(default(byte[])),
+                ex => Assert.AreEqual("values", ex.ParamName));
+
+            AssertEx.Throws<ArgumentNullException>(
+                () => new TypedArray(default(int[])),
+                ex => Assert.AreEqual("values", ex.ParamName));
+
+            AssertEx.Throws<ArgumentNullException>(
+                () => new TypedArray(default(float[])),
+                ex => Assert.AreEqual("values", ex.ParamName));
+
+            AssertEx.Throws<ArgumentNullException>(
+                () => new TypedArray(default(double[])),
+                ex => Assert.AreEqual("values", ex.ParamName));
+        }
+
+        [TestMethod]
+        public async Task TypedArray_RoundTrip_Uint8()
+        {
+            var result = await RoundTripAsync(new TypedArray(new byte[] { 0, 1, 255 }));
+            Assert.AreEqual("[object Uint8Array]", result.JavaScriptType);
+            CollectionAssert.AreEqual(new byte[] { 0, 1, 255 }, result.Value.ToObject<byte[]>());
+        }
+
+        [TestMethod]
+        public async Task TypedArray_RoundTrip_Int32()
+        {
+            var result = await RoundTripAsync(new TypedArray(new[] { int.MinValue, -1, 0, int.MaxValue }));
+            Assert.AreEqual("[object Int32Array]", result.JavaScriptType);
+            CollectionAssert.AreEqual(new[] { int.MinValue, -1, 0, int.MaxValue }, result.Value.ToObject<int[]>());
+        }
+
+        [TestMethod]
+        public async Task TypedArray_RoundTrip_Float32()
+        {
+            var result = await RoundTripAsync(new TypedArray(new[] { -2.25f, 0.0f, 1.5f }));
+            Assert.AreEqual("[object Float32Array]", result.JavaScriptType);
+            CollectionAssert.AreEqual(new[] { -2.25f, 0.0f, 1.5f }, result.Value.ToObject<float[]>());
+        }
+
+        [TestMethod]
+        public async Task TypedArray_RoundTrip_Float64()
+        {
+            var result = await RoundTripAsync(new TypedArray(new[] { -0.1, 0.0, double.MaxValue }));
+            Assert.AreEqual("[object Float64Array]", result.JavaScriptType);
+            CollectionAssert.AreEqual(new[] { -0.1, 0.0, double.MaxValue }, result.Value.ToObject<double[]>());
+        }
+
+        [TestMethod]
+        public async Task TypedArray_PlainArrays()
+        {
+            // Unwrapped arrays keep marshaling as plain JavaScript arrays.
+            var bytes = await RoundTripAsync(new byte[] { 1, 2 });
+            Assert.AreEqual("[object Array]", bytes.JavaScriptType);
+            CollectionAssert.AreEqual(new byte[] { 1, 2 }, bytes.Value.ToObject<byte[]>());
+
+            var doubles = await RoundTripAsync(new[] { 1.5, 2.5 });
+            Assert.AreEqual("[object Array]", doubles.JavaScriptType);
+            CollectionAssert.AreEqual(new[] { 1.5, 2.5 }, doubles.Value.ToObject<double[]>());
+        }
+
+        [TestMethod]
+        public async Task TypedArray_FromJavaScript_Signs()
+        {
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var pool = new JavaScriptInstancePool(thread, new TestBundleLoader(BatchedBridgeScript), 0))
+                {
+                    var callback = new RecordingReactCallback();
+                    using (var instance = await pool.AcquireAsync(callback))
+                    {
+                        await instance.JSQueueThread.CallOnQueue(() =>
+                        {
+                            instance.Bridge.CallFunction(0, 0, new JArray());
+                            return true;
+                        });
+
+                        var parameters = (JArray)((JArray)callback.Batch[2])[0];
+                        CollectionAssert.AreEqual(new long[] { -1, 127, -128 }, parameters[0].ToObject<long[]>());
+                        CollectionAssert.AreEqual(new long[] { 4294967295, 1 }, parameters[1].ToObject<long[]>());
+                        CollectionAssert.AreEqual(new long[] { -2 }, parameters[2].ToObject<long[]>());
+                        CollectionAssert.AreEqual(new long[] { 65535 }, parameters[3].ToObject<long[]>());
+                    }
+                }
+            }
+        }
+
+        private static async Task<RoundTripResult> RoundTripAsync(object value)
+        {
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                using (var pool = new JavaScriptInstancePool(thread, new TestBundleLoader(BatchedBridgeScript), 0))
+                {
+                    var callback = new RecordingReactCallback();
+                    using (var instance = await pool.AcquireAsync(callback))
+                    {
+                        var javaScriptType = await instance.JSQueueThread.CallOnQueue(() =>
+                        {
+                            instance.Bridge.InvokeCallback(1, new[] { value });
+                            return JavaScriptContext.RunScript("Object.prototype.toString.call(received)").ToString();
+                        });
+
+                        var parameters = (JArray)((JArray)callback.Batch[2])[0];
+                        return new RoundTripResult(javaScriptType, parameters[0]);
+                    }
+                }
+            }
+        }
+
+        class RoundTripResult
+        {
+            public RoundTripResult(string javaScriptType, JToken value)
+            {
+                JavaScriptType = javaScriptType;
+                Value = value;
+            }
+
+            public string JavaScriptType { get; }
+
+            public JToken Value { get; }
+        }
+
+        class RecordingReactCallback : IReactCallback
+        {
+            public JArray Batch { get; private set; }
+
+            public void Invoke(JsonReader batch)
+            {
+                Batch = JArray.Load(batch);
+            }
+        }
+    }
+}
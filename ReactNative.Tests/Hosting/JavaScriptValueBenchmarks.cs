@@ -0,0 +1,208 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using ReactNative.Hosting;
+using System;
+using System.Globalization;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace ReactNative.Tests.Hosting
+{
+    [TestClass]
+    public class JavaScriptValueBenchmarks
+    {
+        private const int OperationCount = 100000;
+        private const int ScriptRunCount = 10;
+        private const int BundleModuleCount = 2000;
+        private const int ArrayLength = 10000;
+
+        [TestMethod]
+        [TestCategory("Benchmark")]
+        public void JavaScriptValue_Benchmark_Properties()
+        {
+            using (var runtime = JavaScriptRuntime.Create())
+            using (new JavaScriptContext.Scope(runtime.CreateContext()))
+            {
+                var obj = JavaScriptValue.CreateObject();
+                var propertyId = JavaScriptPropertyId.FromString("foo");
+                var value = JavaScriptValue.FromInt32(42);
+
+                Benchmark.Run("JavaScriptValue.SetProperty", OperationCount, () =>
+                {
+                    for (var i = 0; i < OperationCount; ++i)
+                    {
+                        obj.SetProperty(propertyId, value, true);
+                    }
+                });
+
+                Benchmark.Run("JavaScriptValue.GetProperty", OperationCount, () =>
+                {
+                    for (var i = 0; i < OperationCount; ++i)
+                    {
+                        obj.GetProperty(propertyId);
+                    }
+                });
+
+                Benchmark.Run("JavaScriptPropertyId.FromString", OperationCount, () =>
+                {
+                    for (var i = 0; i < OperationCount; ++i)
+                    {
+                        JavaScriptPropertyId.FromString("foo");
+                    }
+                });
+            }
+        }
+
+        [TestMethod]
+        [TestCategory("Benchmark")]
+        public void JavaScriptValue_Benchmark_CallFunction()
+        {
+            using (var runtime = JavaScriptRuntime.Create())
+            using (new JavaScriptContext.Scope(runtime.CreateContext()))
+            {
+                var function = JavaScriptContext.RunScript("(function (a, b, c) { return a; })");
+                var thisArg = JavaScriptValue.Undefined;
+                var a = JavaScriptValue.FromInt32(1);
+                var b = JavaScriptValue.FromDouble(0.5);
+                var c = JavaScriptValue.True;
+
+                Benchmark.Run("JavaScriptValue.CallFunction(this, a, b, c)", OperationCount, () =>
+                {
+                    for (var i = 0; i < OperationCount; ++i)
+                    {
+                        function.CallFunction(thisArg, a, b, c);
+                    }
+                });
+
+                Benchmark.Run("JavaScriptValue.CallFunction(params)", OperationCount, () =>
+                {
+                    for (var i = 0; i < OperationCount; ++i)
+                    {
+                        function.CallFunction(new[] { thisArg, a, b, c });
+                    }
+                });
+            }
+        }
+
+        [TestMethod]
+        [TestCategory("Benchmark")]
+        public void JavaScriptValue_Benchmark_Arrays()
+        {
+            using (var runtime = JavaScriptRuntime.Create())
+            using (new JavaScriptContext.Scope(runtime.CreateContext()))
+            {
+                var values = new double[ArrayLength];
+                for (var i = 0; i < values.Length; ++i)
+                {
+                    values[i] = i * 0.5;
+                }
+
+                Benchmark.Run("JavaScriptValue.SetIndexedProperty (array)", ArrayLength, () =>
+                {
+                    var array = JavaScriptValue.CreateArray((uint)values.Length);
+                    for (var i = 0; i < values.Length; ++i)
+                    {
+                        array.SetIndexedProperty(JavaScriptValue.FromInt32(i), JavaScriptValue.FromDouble(values[i]));
+                    }
+                });
+
+                Benchmark.Run("JavaScriptValue.CreateTypedArray (copy)", ArrayLength, () =>
+                {
+                    var array = JavaScriptValue.CreateTypedArray(JavaScriptTypedArrayType.Float64, JavaScriptValue.Invalid, 0, (uint)values.Length);
+                    var byteLength = default(uint);
+                    var arrayType = default(JavaScriptTypedArrayType);
+                    var elementSize = default(int);
+                    var storage = array.GetTypedArrayStorage(out byteLength, out arrayType, out elementSize);
+                    Marshal.Copy(values, 0, storage, values.Length);
+                });
+            }
+        }
+
+        [TestMethod]
+        [TestCategory("Benchmark")]
+        public void JavaScriptContext_Benchmark_RunScript()
+        {
+            var script = CreateBundle();
+
+            //
+            // The runtime reads the source and the serialized script lazily,
+            // so both stay pinned until the runtime is disposed.
+            //
+            var scriptHandle = GCHandle.Alloc(script, GCHandleType.Pinned);
+            var bufferHandle = default(GCHandle);
+            try
+            {
+                using (var runtime = JavaScriptRuntime.Create())
+                {
+                    var buffer = default(byte[]);
+                    using (new JavaScriptContext.Scope(runtime.CreateContext()))
+                    {
+                        buffer = new byte[JavaScriptContext.SerializeScript(script, null)];
+                        JavaScriptContext.SerializeScript(script, buffer);
+                    }
+
+                    bufferHandle = GCHandle.Alloc(buffer, GCHandleType.Pinned);
+
+                    // Each run starts from a new context, like a cold start.
+                    Benchmark.Run("JavaScriptContext.RunScript", ScriptRunCount, () =>
+                    {
+                        for (var i = 0; i < ScriptRunCount; ++i)
+                        {
+                            using (new JavaScriptContext.Scope(runtime.CreateContext()))
+                            {
+                                JavaScriptContext.RunScript(script);
+                            }
+                        }
+                    });
+
+                    Benchmark.Run("JavaScriptContext.RunScript (serialized)", ScriptRunCount, () =>
+                    {
+                        for (var i = 0; i < ScriptRunCount; ++i)
+                        {
+                            using (new JavaScriptContext.Scope(runtime.CreateContext()))
+                            {
+                                JavaScriptContext.RunScript(
+                                    scriptHandle.AddrOfPinnedObject(),
+                                    bufferHandle.AddrOfPinnedObject(),
+                                    JavaScriptSourceContext.FromIntPtr(IntPtr.Zero),
+                                    string.Empty);
+                            }
+                        }
+                    });
+                }
+            }
+            finally
+            {
+                if (bufferHandle.IsAllocated)
+                {
+                    bufferHandle.Free();
+                }
+
+                scriptHandle.Free();
+            }
+        }
+
+        private static string CreateBundle()
+        {
+            //
+            // Mirrors the shape of a packaged bundle: many small module
+            // factories registered up front, few of them required.
+            //
+            var builder = new StringBuilder();
+            builder.AppendLine("var modules = {};");
+            builder.AppendLine("function __d(id, factory) { modules[id] = { factory: factory, exports: null }; }");
+            builder.AppendLine("function require(id) { var m = modules[id]; if (!m.exports) { m.exports = {}; m.factory(require, m, m.exports); } return m.exports; }");
+
+            for (var i = 0; i < BundleModuleCount; ++i)
+            {
+                builder.AppendFormat(
+                    CultureInfo.InvariantCulture,
+                    "__d('m{0}', function(require, module, exports) {{ var styles = {{ width: {0}, height: {0}, flex: 1 }}; module.exports = function(props) {{ return {{ id: {0}, style: styles, text: 'Module ' + props.name }}; }}; }});",
+                    i);
+                builder.AppendLine();
+            }
+
+            builder.AppendLine("for (var i = 0; i < 100; ++i) { require('m' + i)({ name: 'foo' }); }");
+            return builder.ToString();
+        }
+    }
+}
@@ -0,0 +1,67 @@
+﻿using System;
+using System.Diagnostics;
+using System.Globalization;
+using System.Threading.Tasks;
+
+namespace ReactNative.Tests
+{
+    /// <summary>
+    /// Runs micro-benchmarks and reports the median time per operation.
+    /// </summary>
+    /// <remarks>
+    /// Each benchmark is warmed up, then sampled several times with a
+    /// collection in between, so results are comparable between runs on the
+    /// same device. Results are written to the debug output in the form
+    /// <c>Benchmark {name}: {median} ns/op (min {min}, max {max})</c>.
+    /// </remarks>
+    static class Benchmark
+    {
+        private const int WarmupCount = 2;
+        private const int SampleCount = 9;
+
+        public static double Run(string name, int operationCount, Action sample)
+        {
+            return Run(name, operationCount, () =>
+            {
+                sample();
+                return Task.FromResult(true);
+            }).Result;
+        }
+
+        public static async Task<double> Run(string name, int operationCount, Func<Task> sample)
+        {
+            for (var i = 0; i < WarmupCount; ++i)
+            {
+                await sample();
+            }
+
+            var results = new double[SampleCount];
+            for (var i = 0; i < SampleCount; ++i)
+            {
+                GC.Collect();
+                GC.WaitForPendingFinalizers();
+                GC.Collect();
+
+                var stopwatch = Stopwatch.StartNew();
+                await sample();
+                stopwatch.Stop();
+
+                results[i] = stopwatch.Elapsed.TotalMilliseconds * 1000000 / operationCount;
+            }
+
+            Array.Sort(results);
+            var median = results[SampleCount / 2];
+
+            Debug.WriteLine(
+                string.Format(
+                    CultureInfo.InvariantCulture,
+                    "Benchmark {0}: {1:F1} ns/op (min {2:F1}, max {3:F1})",
+                    name,
+                    median,
+                    results[0],
+                    results[SampleCount - 1]));
+
+            return median;
+        }
+    }
+}
@@ -0,0 +1,63 @@
+﻿using Newtonsoft.Json.Linq;
+using ReactNative.Bridge;
+using System;
+using System.Collections.Generic;
+
+namespace ReactNative.Tests
+{
+    class MockCatalystInstance : ICatalystInstance
+    {
+        private readonly Action<int, object[]> _onInvokeCallback;
+        private readonly Action<IList<int>, IList<object[]>> _onInvokeCallbacks;
+
+        public MockCatalystInstance(Action<int, object[]> onInvokeCallback)
+            : this(onInvokeCallback, null)
+        {
+        }
+
+        public MockCatalystInstance(Action<int, object[]> onInvokeCallback, Action<IList<int>, IList<object[]>> onInvokeCallbacks)
+        {
+            _onInvokeCallback = onInvokeCallback;
+            _onInvokeCallbacks = onInvokeCallbacks ?? ((callbackIds, argumentsList) =>
+            {
+                for (var i = 0; i < callbackIds.Count; ++i)
+                {
+                    onInvokeCallback(callbackIds[i], argumentsList[i]);
+                }
+            });
+        }
+
+        public ICollection<INativeModule> NativeModules
+        {
+            get
+            {
+                throw new NotImplementedException();
+            }
+        }
+
+        public void InvokeCallback(int callbackId, JArray arguments)
+        {
+            throw new NotImplementedException();
+        }
+
+        public void InvokeCallback(int callbackId, object[] arguments)
+        {
+            _onInvokeCallback(callbackId, arguments);
+        }
+
+        public void InvokeCallbacks(IList<int> callbackIds, IList<object[]> argumentsList)
+        {
+            _onInvokeCallbacks(callbackIds, argumentsList);
+        }
+
+        public void Initialize()
+        {
+            throw new NotImplementedException();
+        }
+
+        public T GetNativeModule<T>(Type nativeModuleInterface) where T : INativeModule
+        {
+            throw new NotImplementedException();
+        }
+    }
+}
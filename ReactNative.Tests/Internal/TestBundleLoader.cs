@@ -0,0 +1,58 @@
+﻿using ReactNative.Bridge;
+using System.Threading;
+using System.Threading.Tasks;
+
+namespace ReactNative.Tests
+{
+    /// <summary>
+    /// Loads a script given in code, and counts how often it is used.
+    /// </summary>
+    class TestBundleLoader : JavaScriptBundleLoader
+    {
+        private readonly string _script;
+
+        private int _initializeCount;
+        private int _loadCount;
+
+        public TestBundleLoader(string script)
+        {
+            _script = script;
+        }
+
+        public int InitializeCount
+        {
+            get
+            {
+                return Volatile.Read(ref _initializeCount);
+            }
+        }
+
+        public int LoadCount
+        {
+            get
+            {
+                return Volatile.Read(ref _loadCount);
+            }
+        }
+
+        public override string SourceUrl
+        {
+            get
+            {
+                return "test.js";
+            }
+        }
+
+        public override Task InitializeAsync()
+        {
+            Interlocked.Increment(ref _initializeCount);
+            return Task.FromResult(true);
+        }
+
+        public override void LoadScript(IReactBridge bridge)
+        {
+            Interlocked.Increment(ref _loadCount);
+            bridge.RunScript(_script, SourceUrl);
+        }
+    }
+}
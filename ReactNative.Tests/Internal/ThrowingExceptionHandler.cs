@@ -0,0 +1,14 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using ReactNative.Bridge.Queue;
+using System;
+
+namespace ReactNative.Tests
+{
+    class ThrowingExceptionHandler : IQueueThreadExceptionHandler
+    {
+        public void HandleException(Exception ex)
+        {
+            Assert.Fail("Unexpected exception: {0}", ex);
+        }
+    }
+}
@@ -0,0 +1,56 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using Newtonsoft.Json.Linq;
+using ReactNative.Bridge.Queue;
+using ReactNative.Hosting;
+using ReactNative.Tracing;
+using System.IO;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace ReactNative.Tests.Tracing
+{
+    [TestClass]
+    public class JavaScriptProfilerTests
+    {
+        [TestMethod]
+        public async Task JavaScriptProfiler_WriteTrace()
+        {
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                var profiler = new JavaScriptProfiler(thread, 1024);
+                await profiler.StartAsync();
+                Assert.IsTrue(profiler.IsProfiling);
+
+                await thread.CallOnQueue(() => JavaScriptContext.RunScript("function foo() { return 42; } foo(); foo();"));
+                await profiler.StopAsync();
+                Assert.IsFalse(profiler.IsProfiling);
+
+                var writer = new StringWriter();
+                profiler.WriteTrace(writer);
+
+                var events = (JArray)JObject.Parse(writer.ToString())["traceEvents"];
+                Assert.AreEqual(2, events.Count(e => e.Value<string>("name") == "foo" && e.Value<string>("ph") == "B"));
+                Assert.AreEqual(2, events.Count(e => e.Value<string>("name") == "foo" && e.Value<string>("ph") == "E"));
+                Assert.AreEqual(0, profiler.DroppedEventCount);
+            }
+        }
+
+        [TestMethod]
+        public async Task JavaScriptProfiler_TakeHeapSnapshot()
+        {
+            using (var thread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, new ThrowingExceptionHandler()))
+            {
+                thread.Start();
+
+                await thread.CallOnQueue(() => JavaScriptContext.RunScript("var objects = []; for (var i = 0; i < 100; ++i) { objects.push({ i: i }); }"));
+
+                var profiler = new JavaScriptProfiler(thread);
+                var snapshot = await profiler.TakeHeapSnapshotAsync();
+                Assert.IsTrue(snapshot.Count > 0);
+                Assert.IsTrue(snapshot.Sum(summary => summary.ObjectCount) >= 100);
+            }
+        }
+    }
+}
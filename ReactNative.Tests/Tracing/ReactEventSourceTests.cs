@@ -0,0 +1,133 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using Newtonsoft.Json.Linq;
+using ReactNative.Bridge;
+using ReactNative.Tracing;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics.Tracing;
+using System.Linq;
+
+namespace ReactNative.Tests.Tracing
+{
+    [TestClass]
+    public class ReactEventSourceTests
+    {
+        [TestMethod]
+        public void ReactEventSource_InvokeBatch()
+        {
+            var registry = new NativeModuleRegistry.Builder()
+                .Add(new TestModule())
+                .Build();
+
+            // Nothing is recorded before a listener enables the source.
+            registry.InvokeBatch(null, JArray.Parse("[[0],[0],[[]]]"));
+
+            using (var listener = new TestEventListener())
+            {
+                listener.EnableEvents(
+                    ReactEventSource.Log,
+                    EventLevel.Verbose,
+                    ReactEventSource.Keywords.NativeCall | ReactEventSource.Keywords.Batch);
+
+                registry.InvokeBatch(null, JArray.Parse("[[0,0],[0,0],[[],[]]]"));
+
+                CollectionAssert.AreEqual(
+                    new[]
+                    {
+                        "BatchStart",
+                        "NativeCallStart",
+                        "NativeCallArgumentsDecoded",
+                        "NativeCallStop",
+                        "NativeCallStart",
+                        "NativeCallArgumentsDecoded",
+                        "NativeCallStop",
+                        "BatchStop",
+                    },
+                    listener.Events.Select(e => e.EventName).ToList());
+
+                Assert.AreEqual("NativeCall__Test_Foo", listener.Events[1].Payload[0]);
+                Assert.AreEqual("NativeCall__Test_Foo", listener.Events[2].Payload[0]);
+                Assert.AreEqual(2, listener.Events[0].Payload[0]);
+            }
+        }
+
+        [TestMethod]
+        public void ReactEventSource_InvokeBatch_Throws()
+        {
+            var registry = new NativeModuleRegistry.Builder()
+                .Add(new TestModule())
+                .Build();
+
+            using (var listener = new TestEventListener())
+            {
+                listener.EnableEvents(
+                    ReactEventSource.Log,
+                    EventLevel.Verbose,
+                    ReactEventSource.Keywords.NativeCall | ReactEventSource.Keywords.Batch);
+
+                AssertEx.Throws<InvalidOperationException>(() => registry.InvokeBatch(null, JArray.Parse("[[0],[1],[[]]]")));
+
+                CollectionAssert.AreEqual(
+                    new[]
+                    {
+                        "BatchStart",
+                        "NativeCallStart",
+                        "NativeCallArgumentsDecoded",
+                        "NativeCallStop",
+                        "BatchStop",
+                    },
+                    listener.Events.Select(e => e.EventName).ToList());
+            }
+        }
+
+        [TestMethod]
+        public void ReactEventSource_IsEnabled_Level()
+        {
+            using (var listener = new TestEventListener())
+            {
+                listener.EnableEvents(
+                    ReactEventSource.Log,
+                    EventLevel.Warning,
+                    ReactEventSource.Keywords.Queue | ReactEventSource.Keywords.Memory);
+
+                // Warnings are written without verbose tracing, but
+                // informational events are not.
+                Assert.IsFalse(ReactEventSource.Log.IsEnabled(ReactEventSource.Keywords.Queue));
+                Assert.IsTrue(ReactEventSource.Log.IsEnabled(EventLevel.Warning, ReactEventSource.Keywords.Queue));
+                Assert.IsFalse(ReactEventSource.Log.IsEnabled(EventLevel.Informational, ReactEventSource.Keywords.Memory));
+            }
+        }
+
+        class TestModule : NativeModuleBase
+        {
+            public override string Name
+            {
+                get
+                {
+                    return "Test";
+                }
+            }
+
+            [ReactMethod]
+            public void Foo()
+            {
+            }
+
+            [ReactMethod]
+            public void Fail()
+            {
+                throw new InvalidOperationException();
+            }
+        }
+
+        class TestEventListener : EventListener
+        {
+            public List<EventWrittenEventArgs> Events { get; } = new List<EventWrittenEventArgs>();
+
+            protected override void OnEventWritten(EventWrittenEventArgs eventData)
+            {
+                Events.Add(eventData);
+            }
+        }
+    }
+}
@@ -0,0 +1,152 @@
+﻿using Microsoft.VisualStudio.TestPlatform.UnitTestFramework;
+using Newtonsoft.Json.Linq;
+using ReactNative.Bridge;
+using ReactNative.Bridge.Queue;
+using ReactNative.UIManager;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Threading.Tasks;
+using Windows.ApplicationModel.Core;
+using Windows.UI.Core;
+using Windows.UI.Xaml.Media;
+
+namespace ReactNative.Tests.UIManager
+{
+    [TestClass]
+    public class UIViewOperationQueueTests
+    {
+        [TestMethod]
+        public async Task UIViewOperationQueue_ArgumentChecks()
+        {
+            await RunOnDispatcherAsync(() =>
+            {
+                AssertEx.Throws<ArgumentNullException>(
+                    () => new UIViewOperationQueue(null),
+                    ex => Assert.AreEqual("handler", ex.ParamName));
+
+                AssertEx.Throws<ArgumentOutOfRangeException>(
+                    () => new UIViewOperationQueue(new ThrowingExceptionHandler(), TimeSpan.Zero),
+                    ex => Assert.AreEqual("frameBudget", ex.ParamName));
+
+                var queue = new UIViewOperationQueue(new ThrowingExceptionHandler());
+                AssertEx.Throws<ArgumentNullException>(
+                    () => queue.EnqueueOperation(null),
+                    ex => Assert.AreEqual("operation", ex.ParamName));
+            });
+        }
+
+        [TestMethod]
+        public async Task UIViewOperationQueue_FrameBudget_CarriesOver()
+        {
+            var frame = 0;
+            var frames = new List<int>();
+            var completed = new TaskCompletionSource<bool>();
+            var onFrame = new EventHandler<object>((sender, e) => ++frame);
+
+            await RunOnDispatcherAsync(() =>
+            {
+                // Registered first, so the count moves before the queue runs.
+                CompositionTarget.Rendering += onFrame;
+
+                var queue = new UIViewOperationQueue(new ThrowingExceptionHandler(), TimeSpan.FromMilliseconds(1));
+                queue.EnqueueOperation(() =>
+                {
+                    frames.Add(frame);
+
+                    // Spend the whole budget on the first batch.
+                    var stopwatch = Stopwatch.StartNew();
+                    while (stopwatch.ElapsedMilliseconds < 5)
+                    {
+                    }
+                });
+
+                queue.DispatchViewUpdates();
+
+                queue.EnqueueOperation(() =>
+                {
+                    frames.Add(frame);
+                    completed.SetResult(true);
+                });
+
+                queue.DispatchViewUpdates();
+            });
+
+            await completed.Task;
+            await RunOnDispatcherAsync(() => CompositionTarget.Rendering -= onFrame);
+
+            Assert.AreEqual(2, frames.Count);
+            Assert.IsTrue(frames[1] > frames[0]);
+        }
+
+        [TestMethod]
+        public async Task UIViewOperationQueue_DispatchOnBatchComplete()
+        {
+            var completed = new TaskCompletionSource<bool>();
+            var queue = default(UIViewOperationQueue);
+            await RunOnDispatcherAsync(() => queue = new UIViewOperationQueue(new ThrowingExceptionHandler()));
+
+            var registry = new NativeModuleRegistry.Builder()
+                .Add(new UIManagerModule(queue))
+                .Build();
+
+            // The operations wait for the native call batch to complete.
+            queue.EnqueueOperation(() => completed.SetResult(true));
+            await Task.Delay(50);
+            Assert.IsFalse(completed.Task.IsCompleted);
+
+            registry.InvokeBatch(null, JArray.Parse("[[],[],[]]"));
+            await completed.Task;
+        }
+
+        [TestMethod]
+        public async Task UIViewOperationQueue_OperationThrows()
+        {
+            var handler = new RecordingExceptionHandler();
+            var completed = new TaskCompletionSource<bool>();
+
+            await RunOnDispatcherAsync(() =>
+            {
+                var queue = new UIViewOperationQueue(handler);
+                queue.EnqueueOperation(() => { throw new InvalidOperationException("Expected."); });
+                queue.EnqueueOperation(() => completed.SetResult(true));
+                queue.DispatchViewUpdates();
+            });
+
+            // The operation after the failing one still runs.
+            await completed.Task;
+            Assert.IsInstanceOfType(handler.Exception, typeof(InvalidOperationException));
+        }
+
+        private static async Task RunOnDispatcherAsync(Action action)
+        {
+            var exception = default(Exception);
+            await CoreApplication.MainView.CoreWindow.Dispatcher.RunAsync(CoreDispatcherPriority.Normal, () =>
+            {
+                try
+                {
+                    action();
+                }
+                catch (Exception ex)
+                {
+                    exception = ex;
+                }
+            });
+
+            if (exception != null)
+            {
+                throw exception;
+            }
+        }
+
+        class RecordingExceptionHandler : IQueueThreadExceptionHandler
+        {
+            public Exception Exception { get; private set; }
+
+            public void HandleException(Exception ex)
+            {
+                Exception = ex;
+            }
+        }
+    }
+}
@@ -0,0 +1,155 @@
+﻿using System;
+using System.Collections.Generic;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// Holds the callbacks invoked while a native call batch runs on the
+    /// current thread, so they are sent to JavaScript together once the
+    /// batch ends.
+    /// </summary>
+    /// <remarks>
+    /// Callbacks invoked outside of a batch, e.g., from a module's action
+    /// queue or a task continuation, are sent right away. Each thread
+    /// reuses one batch, so steady-state batches do not allocate.
+    /// </remarks>
+    sealed class CallbackBatch
+    {
+        [ThreadStatic]
+        private static CallbackBatch s_current;
+
+        private List<ICatalystInstance> _instances = new List<ICatalystInstance>();
+        private List<int> _callbackIds = new List<int>();
+        private List<object[]> _argumentsList = new List<object[]>();
+
+        // Filled from the lists above while they are sent, so callbacks
+        // invoked by the batches that sending triggers are not lost.
+        private List<ICatalystInstance> _sendingInstances = new List<ICatalystInstance>();
+        private List<int> _sendingCallbackIds = new List<int>();
+        private List<object[]> _sendingArgumentsList = new List<object[]>();
+
+        private int _depth;
+
+        private CallbackBatch()
+        {
+        }
+
+        /// <summary>
+        /// Starts holding callbacks on the current thread.
+        /// </summary>
+        /// <returns>The batch, to be ended by the caller.</returns>
+        public static CallbackBatch Begin()
+        {
+            var batch = s_current;
+            if (batch == null)
+            {
+                batch = s_current = new CallbackBatch();
+            }
+
+            batch._depth++;
+            return batch;
+        }
+
+        /// <summary>
+        /// Holds a callback invocation, if a batch is running on the current
+        /// thread.
+        /// </summary>
+        /// <param name="instance">The catalyst instance.</param>
+        /// <param name="callbackId">The callback ID.</param>
+        /// <param name="arguments">The arguments.</param>
+        /// <returns>
+        /// <b>true</b> if the invocation is held, <b>false</b> if the caller
+        /// should send it.
+        /// </returns>
+        public static bool TryAdd(ICatalystInstance instance, int callbackId, object[] arguments)
+        {
+            var batch = s_current;
+            if (batch == null || batch._depth == 0)
+            {
+                return false;
+            }
+
+            batch._instances.Add(instance);
+            batch._callbackIds.Add(callbackId);
+            batch._argumentsList.Add(arguments);
+            return true;
+        }
+
+        /// <summary>
+        /// Ends the batch, and sends the held callbacks if it is the
+        /// outermost batch on the thread.
+        /// </summary>
+        public void End()
+        {
+            try
+            {
+                if (_depth == 1)
+                {
+                    //
+                    // Sending callbacks runs JavaScript, and the native calls
+                    // it flushes run as nested batches that may invoke more
+                    // callbacks. Those are sent in the next round.
+                    //
+                    while (_callbackIds.Count > 0)
+                    {
+                        Send();
+                    }
+                }
+            }
+            finally
+            {
+                _depth--;
+            }
+        }
+
+        private void Send()
+        {
+            Swap(ref _instances, ref _sendingInstances);
+            Swap(ref _callbackIds, ref _sendingCallbackIds);
+            Swap(ref _argumentsList, ref _sendingArgumentsList);
+
+            try
+            {
+                var instance = _sendingInstances[0];
+                if (IsSingleInstance(_sendingInstances, instance))
+                {
+                    instance.InvokeCallbacks(_sendingCallbackIds, _sendingArgumentsList);
+                }
+                else
+                {
+                    for (var i = 0; i < _sendingCallbackIds.Count; ++i)
+                    {
+                        _sendingInstances[i].InvokeCallback(_sendingCallbackIds[i], _sendingArgumentsList[i]);
+                    }
+                }
+            }
+            finally
+            {
+                _sendingInstances.Clear();
+                _sendingCallbackIds.Clear();
+                _sendingArgumentsList.Clear();
+            }
+        }
+
+        private static bool IsSingleInstance(List<ICatalystInstance> instances, ICatalystInstance instance)
+        {
+            // A plain loop, so that sending does not allocate a closure.
+            for (var i = 1; i < instances.Count; ++i)
+            {
+                if (instances[i] != instance)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        private static void Swap<T>(ref T x, ref T y)
+        {
+            var temp = x;
+            x = y;
+            y = temp;
+        }
+    }
+}
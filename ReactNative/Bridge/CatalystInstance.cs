@@ -1,40 +1,164 @@
-﻿using System;
+﻿using Newtonsoft.Json.Linq;
+using ReactNative.Bridge.Queue;
+using System;
 using System.Collections.Generic;
-using System.Linq;
-using System.Text;
 using System.Threading.Tasks;
-using Newtonsoft.Json.Linq;
 
 namespace ReactNative.Bridge
 {
-    class CatalystInstance : ICatalystInstance
+    /// <summary>
+    /// A running React instance: a JavaScript instance from the pool, and
+    /// the native modules that its flushed queue calls into.
+    /// </summary>
+    /// <remarks>
+    /// Native calls from JavaScript are bound straight from the flushed
+    /// queue on the JavaScript thread. Callbacks are sent on the JavaScript
+    /// thread, and callbacks invoked during a batch are sent together when
+    /// the batch ends. Must be disposed before the JavaScript thread.
+    /// </remarks>
+    public sealed class CatalystInstance : ICatalystInstance, IDisposable
     {
+        private readonly NativeModuleRegistry _registry;
+
+        private JavaScriptInstance _instance;
+        private bool _initialized;
+
+        /// <summary>
+        /// Instantiates the <see cref="CatalystInstance"/>.
+        /// </summary>
+        /// <param name="registry">The native module registry.</param>
         public CatalystInstance(NativeModuleRegistry registry)
         {
+            if (registry == null)
+                throw new ArgumentNullException(nameof(registry));
 
+            _registry = registry;
         }
 
+        /// <summary>
+        /// The native modules.
+        /// </summary>
         public ICollection<INativeModule> NativeModules
         {
             get
             {
-                throw new NotImplementedException();
+                return _registry.Modules;
+            }
+        }
+
+        /// <summary>
+        /// The JavaScript thread, with the instance's context active.
+        /// </summary>
+        public IMessageQueueThread JSQueueThread
+        {
+            get
+            {
+                return Instance.JSQueueThread;
             }
         }
 
+        /// <summary>
+        /// The bridge, which must only be used on <see cref="JSQueueThread"/>.
+        /// </summary>
+        public IReactBridge Bridge
+        {
+            get
+            {
+                return Instance.Bridge;
+            }
+        }
+
+        private JavaScriptInstance Instance
+        {
+            get
+            {
+                var instance = _instance;
+                if (instance == null)
+                {
+                    throw new InvalidOperationException("Catalyst instance has not acquired a JavaScript instance.");
+                }
+
+                return instance;
+            }
+        }
+
+        /// <summary>
+        /// Acquires the JavaScript instance that native calls come from.
+        /// </summary>
+        /// <param name="pool">The pool to acquire the instance from.</param>
+        /// <returns>A task to await the instance.</returns>
+        public async Task AcquireAsync(JavaScriptInstancePool pool)
+        {
+            if (pool == null)
+                throw new ArgumentNullException(nameof(pool));
+            if (_instance != null)
+                throw new InvalidOperationException("Catalyst instance has already acquired a JavaScript instance.");
+
+            _instance = await pool.AcquireAsync(_registry.CreateReactCallback(this)).ConfigureAwait(false);
+        }
+
         public T GetNativeModule<T>(Type nativeModuleInterface) where T : INativeModule
         {
-            throw new NotImplementedException();
+            return _registry.GetModule<T>();
         }
 
+        /// <summary>
+        /// Initializes the native modules.
+        /// </summary>
         public void Initialize()
         {
-            throw new NotImplementedException();
+            if (_initialized)
+            {
+                throw new InvalidOperationException("Catalyst instance has already been initialized.");
+            }
+
+            _initialized = true;
+            foreach (var module in _registry.Modules)
+            {
+                module.Initialize();
+            }
         }
 
         public void InvokeCallback(int callbackId, JArray arguments)
         {
-            throw new NotImplementedException();
+            var instance = Instance;
+            instance.JSQueueThread.RunOnQueue(() => instance.Bridge.InvokeCallback(callbackId, arguments));
+        }
+
+        public void InvokeCallback(int callbackId, object[] arguments)
+        {
+            var instance = Instance;
+            instance.JSQueueThread.RunOnQueue(() => instance.Bridge.InvokeCallback(callbackId, arguments));
+        }
+
+        public void InvokeCallbacks(IList<int> callbackIds, IList<object[]> argumentsList)
+        {
+            var instance = Instance;
+            instance.JSQueueThread.RunOnQueue(() => instance.Bridge.InvokeCallbacks(callbackIds, argumentsList));
+        }
+
+        /// <summary>
+        /// Tells the native modules the instance is going away, and releases
+        /// the JavaScript instance.
+        /// </summary>
+        public void Dispose()
+        {
+            var instance = _instance;
+            _instance = null;
+            if (instance == null)
+            {
+                return;
+            }
+
+            if (_initialized)
+            {
+                foreach (var module in _registry.Modules)
+                {
+                    module.OnCatalystInstanceDestroy();
+                }
+            }
+
+            instance.Dispose();
         }
     }
 }
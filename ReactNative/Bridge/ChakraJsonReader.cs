@@ -0,0 +1,490 @@
+﻿using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using ReactNative.Hosting;
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// Reads a JavaScript value as a stream of JSON tokens, so native calls
+    /// are bound straight from the flushed queue without building a JSON
+    /// tree first.
+    /// </summary>
+    /// <remarks>
+    /// Follows the conversions of <see cref="ChakraMarshaler.ToJToken"/>.
+    /// The reader walks the value in place, so it must only be used on the
+    /// JavaScript thread while the context is active, and it must be
+    /// closed before the script runs again.
+    /// </remarks>
+    sealed class ChakraJsonReader : JsonReader
+    {
+        private readonly ChakraPropertyIdCache _propertyIds;
+        private readonly Stack<Frame> _frames = new Stack<Frame>();
+
+        private JavaScriptValue _root;
+        private bool _started;
+
+        public ChakraJsonReader(JavaScriptValue value, ChakraPropertyIdCache propertyIds)
+        {
+            if (propertyIds == null)
+                throw new ArgumentNullException(nameof(propertyIds));
+
+            // Values held on the managed heap are not seen by the collector.
+            value.AddRef();
+            _root = value;
+            _propertyIds = propertyIds;
+        }
+
+        public override bool Read()
+        {
+            var token = default(JsonToken);
+            var value = default(object);
+            if (!Next(out token, out value))
+            {
+                SetToken(JsonToken.None);
+                return false;
+            }
+
+            SetToken(token, value);
+            return true;
+        }
+
+        public override int? ReadAsInt32()
+        {
+            var token = default(JsonToken);
+            var value = default(object);
+            if (!Next(out token, out value))
+            {
+                SetToken(JsonToken.None);
+                return null;
+            }
+
+            switch (token)
+            {
+                case JsonToken.Integer:
+                case JsonToken.Float:
+                    var integer = Convert.ToInt32(value, CultureInfo.InvariantCulture);
+                    SetToken(JsonToken.Integer, integer);
+                    return integer;
+                case JsonToken.String:
+                    var s = (string)value;
+                    if (string.IsNullOrEmpty(s))
+                    {
+                        SetToken(JsonToken.Null);
+                        return null;
+                    }
+
+                    var parsed = int.Parse(s, NumberStyles.Integer, CultureInfo.InvariantCulture);
+                    SetToken(JsonToken.Integer, parsed);
+                    return parsed;
+                case JsonToken.Null:
+                case JsonToken.EndArray:
+                    SetToken(token);
+                    return null;
+                default:
+                    throw Unexpected("integer", token);
+            }
+        }
+
+        public override string ReadAsString()
+        {
+            var token = default(JsonToken);
+            var value = default(object);
+            if (!Next(out token, out value))
+            {
+                SetToken(JsonToken.None);
+                return null;
+            }
+
+            switch (token)
+            {
+                case JsonToken.String:
+                case JsonToken.Integer:
+                case JsonToken.Float:
+                case JsonToken.Boolean:
+                    var s = Convert.ToString(value, CultureInfo.InvariantCulture);
+                    SetToken(JsonToken.String, s);
+                    return s;
+                case JsonToken.Null:
+                case JsonToken.EndArray:
+                    SetToken(token);
+                    return null;
+                default:
+                    throw Unexpected("string", token);
+            }
+        }
+
+        public override byte[] ReadAsBytes()
+        {
+            var token = default(JsonToken);
+            var value = default(object);
+            if (!Next(out token, out value))
+            {
+                SetToken(JsonToken.None);
+                return null;
+            }
+
+            switch (token)
+            {
+                case JsonToken.Bytes:
+                    SetToken(JsonToken.Bytes, value);
+                    return (byte[])value;
+                case JsonToken.String:
+                    var bytes = Convert.FromBase64String((string)value);
+                    SetToken(JsonToken.Bytes, bytes);
+                    return bytes;
+                case JsonToken.StartArray:
+                    // Plain and typed arrays of numbers bind as their bytes.
+                    var list = new List<byte>();
+                    while (Next(out token, out value) && token != JsonToken.EndArray)
+                    {
+                        if (token != JsonToken.Integer && token != JsonToken.Float)
+                        {
+                            throw Unexpected("bytes", token);
+                        }
+
+                        list.Add(Convert.ToByte(value, CultureInfo.InvariantCulture));
+                    }
+
+                    var array = list.ToArray();
+                    SetToken(JsonToken.Bytes, array);
+                    return array;
+                case JsonToken.Null:
+                case JsonToken.EndArray:
+                    SetToken(token);
+                    return null;
+                default:
+                    throw Unexpected("bytes", token);
+            }
+        }
+
+        public override decimal? ReadAsDecimal()
+        {
+            var token = default(JsonToken);
+            var value = default(object);
+            if (!Next(out token, out value))
+            {
+                SetToken(JsonToken.None);
+                return null;
+            }
+
+            switch (token)
+            {
+                case JsonToken.Integer:
+                case JsonToken.Float:
+                    var number = Convert.ToDecimal(value, CultureInfo.InvariantCulture);
+                    SetToken(JsonToken.Float, number);
+                    return number;
+                case JsonToken.String:
+                    var s = (string)value;
+                    if (string.IsNullOrEmpty(s))
+                    {
+                        SetToken(JsonToken.Null);
+                        return null;
+                    }
+
+                    var parsed = decimal.Parse(s, NumberStyles.Number, CultureInfo.InvariantCulture);
+                    SetToken(JsonToken.Float, parsed);
+                    return parsed;
+                case JsonToken.Null:
+                case JsonToken.EndArray:
+                    SetToken(token);
+                    return null;
+                default:
+                    throw Unexpected("decimal", token);
+            }
+        }
+
+        public override DateTime? ReadAsDateTime()
+        {
+            var token = default(JsonToken);
+            var value = default(object);
+            if (!Next(out token, out value))
+            {
+                SetToken(JsonToken.None);
+                return null;
+            }
+
+            switch (token)
+            {
+                case JsonToken.String:
+                    var s = (string)value;
+                    if (string.IsNullOrEmpty(s))
+                    {
+                        SetToken(JsonToken.Null);
+                        return null;
+                    }
+
+                    var parsed = DateTime.Parse(s, CultureInfo.InvariantCulture, DateTimeStyles.RoundtripKind);
+                    SetToken(JsonToken.Date, parsed);
+                    return parsed;
+                case JsonToken.Null:
+                case JsonToken.EndArray:
+                    SetToken(token);
+                    return null;
+                default:
+                    throw Unexpected("date", token);
+            }
+        }
+
+        public override DateTimeOffset? ReadAsDateTimeOffset()
+        {
+            var token = default(JsonToken);
+            var value = default(object);
+            if (!Next(out token, out value))
+            {
+                SetToken(JsonToken.None);
+                return null;
+            }
+
+            switch (token)
+            {
+                case JsonToken.String:
+                    var s = (string)value;
+                    if (string.IsNullOrEmpty(s))
+                    {
+                        SetToken(JsonToken.Null);
+                        return null;
+                    }
+
+                    var parsed = DateTimeOffset.Parse(s, CultureInfo.InvariantCulture, DateTimeStyles.RoundtripKind);
+                    SetToken(JsonToken.Date, parsed);
+                    return parsed;
+                case JsonToken.Null:
+                case JsonToken.EndArray:
+                    SetToken(token);
+                    return null;
+                default:
+                    throw Unexpected("date", token);
+            }
+        }
+
+        public override void Close()
+        {
+            base.Close();
+
+            while (_frames.Count > 0)
+            {
+                _frames.Pop().Release();
+            }
+
+            if (_root.IsValid)
+            {
+                _root.Release();
+                _root = JavaScriptValue.Invalid;
+            }
+        }
+
+        //
+        // Moves to the next token without touching the reader state, so the
+        // typed reads can convert the value before it is set once.
+        //
+        private bool Next(out JsonToken token, out object value)
+        {
+            if (!_started)
+            {
+                if (!_root.IsValid)
+                {
+                    throw new ObjectDisposedException(nameof(ChakraJsonReader));
+                }
+
+                _started = true;
+                Start(_root, out token, out value);
+                return true;
+            }
+
+            if (_frames.Count == 0)
+            {
+                token = JsonToken.None;
+                value = null;
+                return false;
+            }
+
+            var frame = _frames.Peek();
+            switch (frame.Kind)
+            {
+                case FrameKind.Array:
+                    if (frame.Index < frame.Length)
+                    {
+                        Start(frame.Value.GetIndexedProperty(JavaScriptValue.FromInt32(frame.Index++)), out token, out value);
+                        return true;
+                    }
+
+                    token = JsonToken.EndArray;
+                    break;
+                case FrameKind.TypedArray:
+                    if (frame.Index < frame.Length)
+                    {
+                        var number = (JValue)frame.Numbers[frame.Index++];
+                        token = number.Type == JTokenType.Integer ? JsonToken.Integer : JsonToken.Float;
+                        value = number.Value;
+                        return true;
+                    }
+
+                    token = JsonToken.EndArray;
+                    break;
+                default:
+                    if (frame.Property.IsValid)
+                    {
+                        var property = frame.Property;
+                        frame.Property = JavaScriptValue.Invalid;
+                        try
+                        {
+                            Start(property, out token, out value);
+                        }
+                        finally
+                        {
+                            property.Release();
+                        }
+
+                        return true;
+                    }
+
+                    // Functions and undefined are dropped, as JSON.stringify does.
+                    while (frame.Index < frame.Length)
+                    {
+                        var name = frame.Names.GetIndexedProperty(JavaScriptValue.FromInt32(frame.Index++)).ToString();
+                        var next = frame.Value.GetProperty(_propertyIds.Get(name));
+                        var type = next.ValueType;
+                        if (type != JavaScriptValueType.Undefined && type != JavaScriptValueType.Function)
+                        {
+                            next.AddRef();
+                            frame.Property = next;
+                            token = JsonToken.PropertyName;
+                            value = name;
+                            return true;
+                        }
+                    }
+
+                    token = JsonToken.EndObject;
+                    break;
+            }
+
+            _frames.Pop().Release();
+            value = null;
+            return true;
+        }
+
+        private void Start(JavaScriptValue item, out JsonToken token, out object value)
+        {
+            value = null;
+            switch (item.ValueType)
+            {
+                case JavaScriptValueType.Boolean:
+                    token = JsonToken.Boolean;
+                    value = item.ToBoolean();
+                    break;
+                case JavaScriptValueType.Number:
+                    var number = ChakraMarshaler.ToNumberToken(item.ToDouble());
+                    token = number.Type == JTokenType.Integer ? JsonToken.Integer : JsonToken.Float;
+                    value = number.Value;
+                    break;
+                case JavaScriptValueType.String:
+                    token = JsonToken.String;
+                    value = item.ToString();
+                    break;
+                case JavaScriptValueType.Array:
+                    Push(new Frame(FrameKind.Array, item, ChakraMarshaler.GetLength(item, _propertyIds)));
+                    token = JsonToken.StartArray;
+                    break;
+                case JavaScriptValueType.TypedArray:
+                    // Typed array storage is read in one copy, as in the marshaler.
+                    var numbers = ChakraMarshaler.TypedArrayToJArray(item);
+                    _frames.Push(new Frame(numbers));
+                    token = JsonToken.StartArray;
+                    break;
+                case JavaScriptValueType.ArrayBuffer:
+                    token = JsonToken.Bytes;
+                    value = ChakraMarshaler.ArrayBufferToJValue(item).Value;
+                    break;
+                case JavaScriptValueType.Object:
+                case JavaScriptValueType.Error:
+                    var names = item.GetOwnPropertyNames();
+                    var frame = new Frame(FrameKind.Object, item, ChakraMarshaler.GetLength(names, _propertyIds));
+                    Push(frame);
+                    names.AddRef();
+                    frame.Names = names;
+                    token = JsonToken.StartObject;
+                    break;
+                default:
+                    token = JsonToken.Null;
+                    break;
+            }
+        }
+
+        private void Push(Frame frame)
+        {
+            frame.Value.AddRef();
+            _frames.Push(frame);
+        }
+
+        private JsonReaderException Unexpected(string expected, JsonToken token)
+        {
+            return new JsonReaderException(
+                string.Format(
+                    CultureInfo.InvariantCulture,
+                    "Error reading {0}. Unexpected token: {1}. Path '{2}'.",
+                    expected,
+                    token,
+                    Path));
+        }
+
+        enum FrameKind
+        {
+            Array,
+            TypedArray,
+            Object,
+        }
+
+        sealed class Frame
+        {
+            public Frame(FrameKind kind, JavaScriptValue value, int length)
+            {
+                Kind = kind;
+                Value = value;
+                Length = length;
+            }
+
+            public Frame(JArray numbers)
+            {
+                Kind = FrameKind.TypedArray;
+                Numbers = numbers;
+                Length = numbers.Count;
+            }
+
+            public FrameKind Kind { get; }
+
+            public JavaScriptValue Value { get; } = JavaScriptValue.Invalid;
+
+            public int Length { get; }
+
+            public JArray Numbers { get; }
+
+            public JavaScriptValue Names { get; set; } = JavaScriptValue.Invalid;
+
+            public JavaScriptValue Property { get; set; } = JavaScriptValue.Invalid;
+
+            public int Index { get; set; }
+
+            public void Release()
+            {
+                if (Property.IsValid)
+                {
+                    Property.Release();
+                }
+
+                if (Names.IsValid)
+                {
+                    Names.Release();
+                }
+
+                if (Value.IsValid)
+                {
+                    Value.Release();
+                }
+            }
+        }
+    }
+}
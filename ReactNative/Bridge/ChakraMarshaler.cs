@@ -0,0 +1,421 @@
+﻿using Newtonsoft.Json.Linq;
+using ReactNative.Hosting;
+using System;
+using System.Collections;
+using System.Globalization;
+using System.Runtime.InteropServices;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// Converts values between .NET and Chakra without going through a
+    /// serialized JSON string on either side of the bridge.
+    /// </summary>
+    /// <remarks>
+    /// All conversions require an active script context.
+    /// </remarks>
+    static class ChakraMarshaler
+    {
+        private static bool s_typedArraysUnavailable;
+        private static bool s_externalArrayBuffersUnavailable;
+
+        /// <summary>
+        /// Converts a .NET value to a JavaScript value.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <param name="propertyIds">The property ID cache of the runtime.</param>
+        /// <returns>The JavaScript value.</returns>
+        public static JavaScriptValue ToJavaScriptValue(object value, ChakraPropertyIdCache propertyIds)
+        {
+            if (value == null)
+            {
+                return JavaScriptValue.Null;
+            }
+
+            var token = value as JToken;
+            if (token != null)
+            {
+                return ToJavaScriptValue(token, propertyIds);
+            }
+
+            var stringValue = value as string;
+            if (stringValue != null)
+            {
+                return JavaScriptValue.FromString(stringValue);
+            }
+
+            if (value is bool)
+            {
+                return JavaScriptValue.FromBoolean((bool)value);
+            }
+
+            if (value is int)
+            {
+                return JavaScriptValue.FromInt32((int)value);
+            }
+
+            if (value is double)
+            {
+                return JavaScriptValue.FromDouble((double)value);
+            }
+
+            if (value is short || value is byte || value is sbyte || value is ushort || value is Enum)
+            {
+                return JavaScriptValue.FromInt32(Convert.ToInt32(value, CultureInfo.InvariantCulture));
+            }
+
+            if (value is float || value is long || value is uint || value is ulong || value is decimal)
+            {
+                return JavaScriptValue.FromDouble(Convert.ToDouble(value, CultureInfo.InvariantCulture));
+            }
+
+            if (value is char)
+            {
+                return JavaScriptValue.FromString(value.ToString());
+            }
+
+            var dictionary = value as IDictionary;
+            if (dictionary != null)
+            {
+                var obj = JavaScriptValue.CreateObject();
+                foreach (DictionaryEntry entry in dictionary)
+                {
+                    obj.SetProperty(
+                        propertyIds.Get(Convert.ToString(entry.Key, CultureInfo.InvariantCulture)),
+                        ToJavaScriptValue(entry.Value, propertyIds),
+                        true);
+                }
+
+                return obj;
+            }
+
+            var buffer = value as NativeBuffer;
+            if (buffer != null)
+            {
+                return ToArrayBuffer(buffer, propertyIds);
+            }
+
+            // Each queued reference is given up once the call is marshaled.
+            var reference = value as NativeBuffer.QueuedReference;
+            if (reference != null)
+            {
+                try
+                {
+                    return ToArrayBuffer(reference.Buffer, propertyIds);
+                }
+                finally
+                {
+                    reference.Release();
+                }
+            }
+
+            var typedArray = value as TypedArray;
+            if (typedArray != null)
+            {
+                return ToTypedArray(typedArray.Values, typedArray.ArrayType, typedArray.CopyTo, propertyIds);
+            }
+
+            var list = value as IList;
+            if (list != null)
+            {
+                return ToArray(list, propertyIds);
+            }
+
+            // Fall back to the serializer contract for arbitrary objects,
+            // which still avoids producing and reparsing a JSON string.
+            return ToJavaScriptValue(JToken.FromObject(value), propertyIds);
+        }
+
+        /// <summary>
+        /// Converts a JSON token to a JavaScript value.
+        /// </summary>
+        /// <param name="token">The token.</param>
+        /// <param name="propertyIds">The property ID cache of the runtime.</param>
+        /// <returns>The JavaScript value.</returns>
+        public static JavaScriptValue ToJavaScriptValue(JToken token, ChakraPropertyIdCache propertyIds)
+        {
+            if (token == null)
+            {
+                return JavaScriptValue.Null;
+            }
+
+            switch (token.Type)
+            {
+                case JTokenType.Object:
+                    var obj = JavaScriptValue.CreateObject();
+                    foreach (var property in (JObject)token)
+                    {
+                        obj.SetProperty(
+                            propertyIds.Get(property.Key),
+                            ToJavaScriptValue(property.Value, propertyIds),
+                            true);
+                    }
+
+                    return obj;
+                case JTokenType.Array:
+                    var source = (JArray)token;
+                    var array = JavaScriptValue.CreateArray((uint)source.Count);
+                    for (var i = 0; i < source.Count; ++i)
+                    {
+                        array.SetIndexedProperty(JavaScriptValue.FromInt32(i), ToJavaScriptValue(source[i], propertyIds));
+                    }
+
+                    return array;
+                case JTokenType.Integer:
+                    var integer = token.Value<long>();
+                    return integer >= int.MinValue && integer <= int.MaxValue
+                        ? JavaScriptValue.FromInt32((int)integer)
+                        : JavaScriptValue.FromDouble(integer);
+                case JTokenType.Float:
+                    return JavaScriptValue.FromDouble(token.Value<double>());
+                case JTokenType.Boolean:
+                    return JavaScriptValue.FromBoolean(token.Value<bool>());
+                case JTokenType.String:
+                    return JavaScriptValue.FromString(token.Value<string>());
+                case JTokenType.Bytes:
+                    var bytes = (byte[])((JValue)token).Value;
+                    return ToTypedArray(bytes, JavaScriptTypedArrayType.Uint8, storage => Marshal.Copy(bytes, 0, storage, bytes.Length), propertyIds);
+                case JTokenType.Null:
+                case JTokenType.Undefined:
+                    return JavaScriptValue.Null;
+                default:
+                    return JavaScriptValue.FromString(token.ToString());
+            }
+        }
+
+        /// <summary>
+        /// Converts a JavaScript value to a JSON token.
+        /// </summary>
+        /// <remarks>
+        /// Follows the <c>JSON.stringify</c> conventions: functions and
+        /// <c>undefined</c> are dropped from objects and become <c>null</c>
+        /// in arrays. Typed arrays are the exception, and become arrays of
+        /// numbers read directly from their storage. ArrayBuffers become
+        /// byte tokens, which bind to <see cref="byte"/> array parameters.
+        /// </remarks>
+        /// <param name="value">The JavaScript value.</param>
+        /// <param name="propertyIds">The property ID cache of the runtime.</param>
+        /// <returns>The JSON token.</returns>
+        public static JToken ToJToken(JavaScriptValue value, ChakraPropertyIdCache propertyIds)
+        {
+            switch (value.ValueType)
+            {
+                case JavaScriptValueType.Boolean:
+                    return new JValue(value.ToBoolean());
+                case JavaScriptValueType.Number:
+                    return ToNumberToken(value.ToDouble());
+                case JavaScriptValueType.String:
+                    return new JValue(value.ToString());
+                case JavaScriptValueType.Array:
+                    return ToJArray(value, propertyIds);
+                case JavaScriptValueType.TypedArray:
+                    return TypedArrayToJArray(value);
+                case JavaScriptValueType.ArrayBuffer:
+                    return ArrayBufferToJValue(value);
+                case JavaScriptValueType.Object:
+                case JavaScriptValueType.Error:
+                    return ToJObject(value, propertyIds);
+                default:
+                    return JValue.CreateNull();
+            }
+        }
+
+        private static JavaScriptValue ToArray(IList list, ChakraPropertyIdCache propertyIds)
+        {
+            var array = JavaScriptValue.CreateArray((uint)list.Count);
+            for (var i = 0; i < list.Count; ++i)
+            {
+                array.SetIndexedProperty(JavaScriptValue.FromInt32(i), ToJavaScriptValue(list[i], propertyIds));
+            }
+
+            return array;
+        }
+
+        private static JavaScriptValue ToTypedArray(IList values, JavaScriptTypedArrayType arrayType, Action<IntPtr> copy, ChakraPropertyIdCache propertyIds)
+        {
+            if (!s_typedArraysUnavailable)
+            {
+                try
+                {
+                    var array = JavaScriptValue.CreateTypedArray(arrayType, JavaScriptValue.Invalid, 0, (uint)values.Count);
+                    var byteLength = default(uint);
+                    var type = default(JavaScriptTypedArrayType);
+                    var elementSize = default(int);
+                    copy(array.GetTypedArrayStorage(out byteLength, out type, out elementSize));
+                    return array;
+                }
+                catch (EntryPointNotFoundException)
+                {
+                    // Only the Edge engine has typed arrays.
+                    s_typedArraysUnavailable = true;
+                }
+            }
+
+            return ToArray(values, propertyIds);
+        }
+
+        private static JavaScriptValue ToArrayBuffer(NativeBuffer buffer, ChakraPropertyIdCache propertyIds)
+        {
+            if (!s_externalArrayBuffersUnavailable)
+            {
+                try
+                {
+                    return buffer.ToArrayBuffer();
+                }
+                catch (EntryPointNotFoundException)
+                {
+                    // Only the Edge engine has external ArrayBuffers.
+                    s_externalArrayBuffersUnavailable = true;
+                }
+            }
+
+            var bytes = buffer.ToArray();
+            return ToTypedArray(bytes, JavaScriptTypedArrayType.Uint8, storage => Marshal.Copy(bytes, 0, storage, bytes.Length), propertyIds);
+        }
+
+        /// <summary>
+        /// Copies the contents of an <c>ArrayBuffer</c> to a byte token.
+        /// </summary>
+        /// <param name="value">The <c>ArrayBuffer</c>.</param>
+        /// <returns>The byte token.</returns>
+        public static JValue ArrayBufferToJValue(JavaScriptValue value)
+        {
+            // The storage belongs to the runtime, and native modules run
+            // after the call returns, so the bytes are copied once.
+            var byteLength = default(uint);
+            var storage = value.GetArrayBufferStorage(out byteLength);
+            var bytes = new byte[byteLength];
+            Marshal.Copy(storage, bytes, 0, bytes.Length);
+            return new JValue(bytes);
+        }
+
+        /// <summary>
+        /// Reads the numbers of a typed array from its storage.
+        /// </summary>
+        /// <param name="value">The typed array.</param>
+        /// <returns>The numbers.</returns>
+        public static JArray TypedArrayToJArray(JavaScriptValue value)
+        {
+            var byteLength = default(uint);
+            var arrayType = default(JavaScriptTypedArrayType);
+            var elementSize = default(int);
+            var storage = value.GetTypedArrayStorage(out byteLength, out arrayType, out elementSize);
+            var count = (int)(byteLength / elementSize);
+
+            var array = new JArray();
+            switch (arrayType)
+            {
+                case JavaScriptTypedArrayType.Int8:
+                case JavaScriptTypedArrayType.Uint8:
+                case JavaScriptTypedArrayType.Uint8Clamped:
+                    var bytes = new byte[count];
+                    Marshal.Copy(storage, bytes, 0, count);
+                    foreach (var item in bytes)
+                    {
+                        array.Add(arrayType == JavaScriptTypedArrayType.Int8 ? (long)(sbyte)item : item);
+                    }
+
+                    break;
+                case JavaScriptTypedArrayType.Int16:
+                case JavaScriptTypedArrayType.Uint16:
+                    var shorts = new short[count];
+                    Marshal.Copy(storage, shorts, 0, count);
+                    foreach (var item in shorts)
+                    {
+                        array.Add(arrayType == JavaScriptTypedArrayType.Int16 ? item : (long)(ushort)item);
+                    }
+
+                    break;
+                case JavaScriptTypedArrayType.Int32:
+                case JavaScriptTypedArrayType.Uint32:
+                    var integers = new int[count];
+                    Marshal.Copy(storage, integers, 0, count);
+                    foreach (var item in integers)
+                    {
+                        array.Add(arrayType == JavaScriptTypedArrayType.Int32 ? item : (long)(uint)item);
+                    }
+
+                    break;
+                case JavaScriptTypedArrayType.Float32:
+                    var floats = new float[count];
+                    Marshal.Copy(storage, floats, 0, count);
+                    foreach (var item in floats)
+                    {
+                        array.Add(ToNumberToken(item));
+                    }
+
+                    break;
+                case JavaScriptTypedArrayType.Float64:
+                    var doubles = new double[count];
+                    Marshal.Copy(storage, doubles, 0, count);
+                    foreach (var item in doubles)
+                    {
+                        array.Add(ToNumberToken(item));
+                    }
+
+                    break;
+            }
+
+            return array;
+        }
+
+        private static JArray ToJArray(JavaScriptValue value, ChakraPropertyIdCache propertyIds)
+        {
+            var length = GetLength(value, propertyIds);
+            var array = new JArray();
+            for (var i = 0; i < length; ++i)
+            {
+                array.Add(ToJToken(value.GetIndexedProperty(JavaScriptValue.FromInt32(i)), propertyIds));
+            }
+
+            return array;
+        }
+
+        private static JObject ToJObject(JavaScriptValue value, ChakraPropertyIdCache propertyIds)
+        {
+            var names = value.GetOwnPropertyNames();
+            var length = GetLength(names, propertyIds);
+            var obj = new JObject();
+            for (var i = 0; i < length; ++i)
+            {
+                var name = names.GetIndexedProperty(JavaScriptValue.FromInt32(i)).ToString();
+                var property = value.GetProperty(propertyIds.Get(name));
+                var type = property.ValueType;
+                if (type != JavaScriptValueType.Undefined && type != JavaScriptValueType.Function)
+                {
+                    obj.Add(name, ToJToken(property, propertyIds));
+                }
+            }
+
+            return obj;
+        }
+
+        /// <summary>
+        /// Gets the <c>length</c> of an array.
+        /// </summary>
+        /// <param name="value">The array.</param>
+        /// <param name="propertyIds">The property ID cache of the runtime.</param>
+        /// <returns>The length.</returns>
+        public static int GetLength(JavaScriptValue value, ChakraPropertyIdCache propertyIds)
+        {
+            return (int)value.GetProperty(propertyIds.Get("length")).ToDouble();
+        }
+
+        /// <summary>
+        /// Converts a JavaScript number to a number token.
+        /// </summary>
+        /// <param name="value">The number.</param>
+        /// <returns>The number token.</returns>
+        public static JValue ToNumberToken(double value)
+        {
+            // Keep integral numbers as integer tokens so they bind to
+            // integral native method parameters the same way parsed JSON does.
+            if (value == Math.Floor(value) && value >= long.MinValue && value <= long.MaxValue)
+            {
+                return new JValue((long)value);
+            }
+
+            return new JValue(value);
+        }
+    }
+}
@@ -0,0 +1,46 @@
+﻿using ReactNative.Hosting;
+using System;
+using System.Collections.Generic;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// Interns property IDs for one JavaScript runtime, so names the bridge
+    /// reads repeatedly are only looked up in the runtime once.
+    /// </summary>
+    /// <remarks>
+    /// Cached IDs hold a reference that is only released with the runtime.
+    /// The cache stops growing once it is full, and further names are looked
+    /// up on every call instead, so arbitrary object keys read from
+    /// JavaScript cannot grow it without bound. Must only be used on the
+    /// JavaScript thread.
+    /// </remarks>
+    sealed class ChakraPropertyIdCache
+    {
+        private const int MaxCount = 1024;
+
+        private readonly Dictionary<string, JavaScriptPropertyId> _propertyIds =
+            new Dictionary<string, JavaScriptPropertyId>(StringComparer.Ordinal);
+
+        public JavaScriptPropertyId Get(string name)
+        {
+            if (name == null)
+                throw new ArgumentNullException(nameof(name));
+
+            var propertyId = default(JavaScriptPropertyId);
+            if (_propertyIds.TryGetValue(name, out propertyId))
+            {
+                return propertyId;
+            }
+
+            propertyId = JavaScriptPropertyId.FromString(name);
+            if (_propertyIds.Count < MaxCount)
+            {
+                propertyId.AddRef();
+                _propertyIds.Add(name, propertyId);
+            }
+
+            return propertyId;
+        }
+    }
+}
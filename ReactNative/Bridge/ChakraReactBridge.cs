@@ -1,23 +1,592 @@
-﻿using System;
-using Newtonsoft.Json.Linq;
+﻿using Newtonsoft.Json.Linq;
+using ReactNative.Hosting;
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Runtime.InteropServices;
 
 namespace ReactNative.Bridge
 {
-    class ChakraReactBridge : IReactBridge
+    /// <summary>
+    /// A bridge to the Chakra runtime that marshals arguments directly to
+    /// and from JavaScript values, without intermediate JSON strings.
+    /// </summary>
+    /// <remarks>
+    /// All members, including <see cref="Dispose"/>, require the JavaScript
+    /// context to be active on the calling thread. The bridge must only be
+    /// disposed once nothing will run in its context again, since that
+    /// unpins the serialized scripts the context was created from.
+    /// </remarks>
+    class ChakraReactBridge : IReactBridge, IDisposable
     {
+        private const string BatchedBridgeName = "__fbBatchedBridge";
+        private const string CallFunctionName = "callFunctionReturnFlushedQueue";
+        private const string InvokeCallbackName = "invokeCallbackAndReturnFlushedQueue";
+
+        private readonly IReactCallback _callback;
+        private readonly ChakraPropertyIdCache _propertyIds = new ChakraPropertyIdCache();
+
+        // The runtime holds on to serialized scripts and their sources until
+        // every function created from them is collected, so both stay pinned.
+        private readonly List<GCHandle> _pinnedScripts = new List<GCHandle>();
+
+        // Native functions handed to the runtime must outlive every
+        // JavaScript function created from them.
+        private readonly List<JavaScriptNativeFunction> _nativeFunctions = new List<JavaScriptNativeFunction>();
+
+        //
+        // The batched bridge and its entry points are resolved on first use
+        // and kept referenced, so steady-state calls do no lookups. The
+        // references are released when the bridge is disposed.
+        //
+        private JavaScriptValue _batchedBridge = JavaScriptValue.Invalid;
+        private JavaScriptValue _callFunction = JavaScriptValue.Invalid;
+        private JavaScriptValue _invokeCallback = JavaScriptValue.Invalid;
+
+        private JavaScriptSourceContext _sourceContext = JavaScriptSourceContext.FromIntPtr(IntPtr.Zero);
+
+        public ChakraReactBridge(IReactCallback callback)
+        {
+            if (callback == null)
+                throw new ArgumentNullException(nameof(callback));
+
+            _callback = callback;
+        }
+
         public void CallFunction(int moduleId, int methodId, JArray arguments)
         {
-            throw new NotImplementedException();
+            CallFunction(moduleId, methodId, ChakraMarshaler.ToJavaScriptValue(arguments, _propertyIds));
+        }
+
+        public void CallFunction(int moduleId, int methodId, object[] arguments)
+        {
+            CallFunction(moduleId, methodId, ChakraMarshaler.ToJavaScriptValue(arguments, _propertyIds));
+        }
+
+        public void CallFunctions(int moduleId, int methodId, IList<object[]> argumentsList)
+        {
+            if (argumentsList == null)
+                throw new ArgumentNullException(nameof(argumentsList));
+
+            EnsureBatchedBridge();
+            var moduleIdValue = JavaScriptValue.FromInt32(moduleId);
+            var methodIdValue = JavaScriptValue.FromInt32(methodId);
+
+            //
+            // Each call returns the native calls it queued. The queues are
+            // merged so native modules see the whole set as one batch.
+            //
+            var batch = JavaScriptValue.Invalid;
+            var isCopy = false;
+            try
+            {
+                foreach (var arguments in argumentsList)
+                {
+                    var response = _callFunction.CallFunction(
+                        _batchedBridge,
+                        moduleIdValue,
+                        methodIdValue,
+                        ChakraMarshaler.ToJavaScriptValue(arguments, _propertyIds));
+
+                    batch = MergeBatch(batch, response, ref isCopy);
+                }
+
+                ProcessResponse(batch);
+            }
+            finally
+            {
+                if (batch.IsValid)
+                {
+                    batch.Release();
+                }
+            }
         }
 
         public void InvokeCallback(int callbackID, JArray arguments)
         {
-            throw new NotImplementedException();
+            InvokeCallback(callbackID, ChakraMarshaler.ToJavaScriptValue(arguments, _propertyIds));
+        }
+
+        public void InvokeCallback(int callbackID, object[] arguments)
+        {
+            InvokeCallback(callbackID, ChakraMarshaler.ToJavaScriptValue(arguments, _propertyIds));
+        }
+
+        public void InvokeCallbacks(IList<int> callbackIDs, IList<object[]> argumentsList)
+        {
+            if (callbackIDs == null)
+                throw new ArgumentNullException(nameof(callbackIDs));
+            if (argumentsList == null)
+                throw new ArgumentNullException(nameof(argumentsList));
+            if (callbackIDs.Count != argumentsList.Count)
+                throw new ArgumentException("Expected arguments for each callback.", nameof(argumentsList));
+
+            EnsureBatchedBridge();
+
+            // As with CallFunctions, the queues are merged into one batch.
+            var batch = JavaScriptValue.Invalid;
+            var isCopy = false;
+            try
+            {
+                for (var i = 0; i < callbackIDs.Count; ++i)
+                {
+                    var response = _invokeCallback.CallFunction(
+                        _batchedBridge,
+                        JavaScriptValue.FromInt32(callbackIDs[i]),
+                        ChakraMarshaler.ToJavaScriptValue(argumentsList[i], _propertyIds));
+
+                    batch = MergeBatch(batch, response, ref isCopy);
+                }
+
+                ProcessResponse(batch);
+            }
+            finally
+            {
+                if (batch.IsValid)
+                {
+                    batch.Release();
+                }
+            }
         }
 
         public void SetGlobalVariable(string propertyName, string jsonEncodedArgument)
         {
-            throw new NotImplementedException();
+            if (propertyName == null)
+                throw new ArgumentNullException(nameof(propertyName));
+            if (jsonEncodedArgument == null)
+                throw new ArgumentNullException(nameof(jsonEncodedArgument));
+
+            var globalObject = JavaScriptValue.GlobalObject;
+            var json = globalObject.GetProperty(_propertyIds.Get("JSON"));
+            var parse = json.GetProperty(_propertyIds.Get("parse"));
+            var value = parse.CallFunction(json, JavaScriptValue.FromString(jsonEncodedArgument));
+            globalObject.SetProperty(_propertyIds.Get(propertyName), value, true);
+        }
+
+        public void SetGlobalVariable(string propertyName, JToken value)
+        {
+            if (propertyName == null)
+                throw new ArgumentNullException(nameof(propertyName));
+            if (value == null)
+                throw new ArgumentNullException(nameof(value));
+
+            JavaScriptValue.GlobalObject.SetProperty(
+                _propertyIds.Get(propertyName),
+                ChakraMarshaler.ToJavaScriptValue(value, _propertyIds),
+                true);
+        }
+
+        public void SetLazyGlobalVariable(string propertyName, IReadOnlyDictionary<string, Func<JToken>> properties)
+        {
+            if (propertyName == null)
+                throw new ArgumentNullException(nameof(propertyName));
+            if (properties == null)
+                throw new ArgumentNullException(nameof(properties));
+
+            var value = JavaScriptValue.CreateObject();
+            foreach (var entry in properties)
+            {
+                DefineLazyProperty(value, entry.Key, entry.Value);
+            }
+
+            JavaScriptValue.GlobalObject.SetProperty(_propertyIds.Get(propertyName), value, true);
+        }
+
+        public void SetGlobalFunction(string propertyName, Action<JArray> function)
+        {
+            if (propertyName == null)
+                throw new ArgumentNullException(nameof(propertyName));
+            if (function == null)
+                throw new ArgumentNullException(nameof(function));
+
+            var nativeFunction = new JavaScriptNativeFunction((callee, isConstructCall, arguments, argumentCount, callbackData) =>
+            {
+                try
+                {
+                    // The first argument is the this value.
+                    var array = new JArray();
+                    for (var i = 1; i < argumentCount; ++i)
+                    {
+                        array.Add(ChakraMarshaler.ToJToken(arguments[i], _propertyIds));
+                    }
+
+                    function(array);
+                    return JavaScriptValue.Undefined;
+                }
+                catch (Exception ex)
+                {
+                    // Exceptions must not unwind through the runtime.
+                    JavaScriptContext.SetException(JavaScriptValue.CreateError(JavaScriptValue.FromString(ex.Message)));
+                    return JavaScriptValue.Invalid;
+                }
+            });
+
+            _nativeFunctions.Add(nativeFunction);
+            JavaScriptValue.GlobalObject.SetProperty(
+                _propertyIds.Get(propertyName),
+                JavaScriptValue.CreateFunction(nativeFunction),
+                true);
+        }
+
+        public void RunScript(string script, string sourceUrl)
+        {
+            if (script == null)
+                throw new ArgumentNullException(nameof(script));
+            if (sourceUrl == null)
+                throw new ArgumentNullException(nameof(sourceUrl));
+
+            JavaScriptContext.RunScript(script, _sourceContext++, sourceUrl);
+        }
+
+        public void RunScript(string script, byte[] serializedScript, string sourceUrl)
+        {
+            if (script == null)
+                throw new ArgumentNullException(nameof(script));
+            if (serializedScript == null)
+                throw new ArgumentNullException(nameof(serializedScript));
+            if (sourceUrl == null)
+                throw new ArgumentNullException(nameof(sourceUrl));
+
+            //
+            // The pinned source is passed by address, so the runtime keeps
+            // the pinned string rather than a marshaled copy. Once the script
+            // has started running, functions it created may refer to both,
+            // so on any other failure they stay pinned until the bridge is
+            // disposed.
+            //
+            var scriptHandle = Pin(script);
+            var bufferHandle = Pin(serializedScript);
+            try
+            {
+                JavaScriptContext.RunScript(scriptHandle.AddrOfPinnedObject(), bufferHandle.AddrOfPinnedObject(), _sourceContext++, sourceUrl);
+            }
+            catch (JavaScriptUsageException)
+            {
+                // A rejected buffer is never referenced by the runtime.
+                Unpin(bufferHandle);
+                Unpin(scriptHandle);
+                throw;
+            }
+        }
+
+        public void RunScript(IntPtr script, IntPtr serializedScript, string sourceUrl)
+        {
+            if (script == IntPtr.Zero)
+                throw new ArgumentNullException(nameof(script));
+            if (serializedScript == IntPtr.Zero)
+                throw new ArgumentNullException(nameof(serializedScript));
+            if (sourceUrl == null)
+                throw new ArgumentNullException(nameof(sourceUrl));
+
+            JavaScriptContext.RunScript(script, serializedScript, _sourceContext++, sourceUrl);
+        }
+
+        public Action ParseScript(string script, string sourceUrl)
+        {
+            if (script == null)
+                throw new ArgumentNullException(nameof(script));
+            if (sourceUrl == null)
+                throw new ArgumentNullException(nameof(sourceUrl));
+
+            return CreateRunAction(JavaScriptContext.ParseScript(script, _sourceContext++, sourceUrl));
+        }
+
+        public Action ParseScript(string script, byte[] serializedScript, string sourceUrl)
+        {
+            if (script == null)
+                throw new ArgumentNullException(nameof(script));
+            if (serializedScript == null)
+                throw new ArgumentNullException(nameof(serializedScript));
+            if (sourceUrl == null)
+                throw new ArgumentNullException(nameof(sourceUrl));
+
+            // As above, but nothing can refer to a script that failed to parse.
+            var scriptHandle = Pin(script);
+            var bufferHandle = Pin(serializedScript);
+            var function = JavaScriptValue.Invalid;
+            try
+            {
+                function = JavaScriptContext.ParseScript(scriptHandle.AddrOfPinnedObject(), bufferHandle.AddrOfPinnedObject(), _sourceContext++, sourceUrl);
+            }
+            finally
+            {
+                if (!function.IsValid)
+                {
+                    Unpin(bufferHandle);
+                    Unpin(scriptHandle);
+                }
+            }
+
+            return CreateRunAction(function);
+        }
+
+        public Action ParseScript(IntPtr script, IntPtr serializedScript, string sourceUrl)
+        {
+            if (script == IntPtr.Zero)
+                throw new ArgumentNullException(nameof(script));
+            if (serializedScript == IntPtr.Zero)
+                throw new ArgumentNullException(nameof(serializedScript));
+            if (sourceUrl == null)
+                throw new ArgumentNullException(nameof(sourceUrl));
+
+            return CreateRunAction(JavaScriptContext.ParseScript(script, serializedScript, _sourceContext++, sourceUrl));
+        }
+
+        public byte[] SerializeScript(string script)
+        {
+            if (script == null)
+                throw new ArgumentNullException(nameof(script));
+
+            var buffer = new byte[JavaScriptContext.SerializeScript(script, null)];
+            JavaScriptContext.SerializeScript(script, buffer);
+            return buffer;
+        }
+
+        public void Dispose()
+        {
+            if (_batchedBridge.IsValid)
+            {
+                _invokeCallback.Release();
+                _callFunction.Release();
+                _batchedBridge.Release();
+
+                _batchedBridge = JavaScriptValue.Invalid;
+                _callFunction = JavaScriptValue.Invalid;
+                _invokeCallback = JavaScriptValue.Invalid;
+            }
+
+            foreach (var handle in _pinnedScripts)
+            {
+                handle.Free();
+            }
+
+            _pinnedScripts.Clear();
+        }
+
+        private void CallFunction(int moduleId, int methodId, JavaScriptValue arguments)
+        {
+            EnsureBatchedBridge();
+            var response = _callFunction.CallFunction(
+                _batchedBridge,
+                JavaScriptValue.FromInt32(moduleId),
+                JavaScriptValue.FromInt32(methodId),
+                arguments);
+
+            ProcessResponse(response);
+        }
+
+        private void InvokeCallback(int callbackID, JavaScriptValue arguments)
+        {
+            EnsureBatchedBridge();
+            var response = _invokeCallback.CallFunction(
+                _batchedBridge,
+                JavaScriptValue.FromInt32(callbackID),
+                arguments);
+
+            ProcessResponse(response);
+        }
+
+        private static Action CreateRunAction(JavaScriptValue function)
+        {
+            // The parsed function is only referenced from native code until
+            // it runs, so it is kept alive explicitly.
+            function.AddRef();
+
+            var hasRun = false;
+            return () =>
+            {
+                if (hasRun)
+                {
+                    throw new InvalidOperationException("Parsed script has already been run.");
+                }
+
+                hasRun = true;
+                try
+                {
+                    function.CallFunction(JavaScriptValue.GlobalObject);
+                }
+                finally
+                {
+                    function.Release();
+                }
+            };
+        }
+
+        private void DefineLazyProperty(JavaScriptValue target, string name, Func<JToken> resolve)
+        {
+            var propertyId = _propertyIds.Get(name);
+            var getter = new JavaScriptNativeFunction((callee, isConstructCall, arguments, argumentCount, callbackData) =>
+            {
+                try
+                {
+                    //
+                    // Replace the accessor with the resolved value on the
+                    // object it was read from, so the value is only
+                    // created once and later reads stay in JavaScript.
+                    //
+                    var value = ChakraMarshaler.ToJavaScriptValue(resolve(), _propertyIds);
+                    var descriptor = JavaScriptValue.CreateObject();
+                    descriptor.SetProperty(_propertyIds.Get("value"), value, true);
+                    descriptor.SetProperty(_propertyIds.Get("enumerable"), JavaScriptValue.True, true);
+                    arguments[0].DefineProperty(propertyId, descriptor);
+                    return value;
+                }
+                catch (Exception ex)
+                {
+                    // Exceptions must not unwind through the runtime.
+                    JavaScriptContext.SetException(JavaScriptValue.CreateError(JavaScriptValue.FromString(ex.Message)));
+                    return JavaScriptValue.Invalid;
+                }
+            });
+
+            _nativeFunctions.Add(getter);
+
+            var accessor = JavaScriptValue.CreateObject();
+            accessor.SetProperty(_propertyIds.Get("get"), JavaScriptValue.CreateFunction(getter), true);
+            accessor.SetProperty(_propertyIds.Get("enumerable"), JavaScriptValue.True, true);
+            accessor.SetProperty(_propertyIds.Get("configurable"), JavaScriptValue.True, true);
+            target.DefineProperty(propertyId, accessor);
+        }
+
+        private void EnsureBatchedBridge()
+        {
+            if (_batchedBridge.IsValid)
+            {
+                return;
+            }
+
+            var batchedBridge = JavaScriptValue.GlobalObject.GetProperty(_propertyIds.Get(BatchedBridgeName));
+            if (batchedBridge.ValueType != JavaScriptValueType.Object)
+            {
+                throw new InvalidOperationException("Could not resolve the batched bridge, check that the bundle has been loaded.");
+            }
+
+            var callFunction = GetFunction(batchedBridge, CallFunctionName);
+            var invokeCallback = GetFunction(batchedBridge, InvokeCallbackName);
+
+            batchedBridge.AddRef();
+            callFunction.AddRef();
+            invokeCallback.AddRef();
+
+            _batchedBridge = batchedBridge;
+            _callFunction = callFunction;
+            _invokeCallback = invokeCallback;
+        }
+
+        private JavaScriptValue GetFunction(JavaScriptValue target, string name)
+        {
+            var function = target.GetProperty(_propertyIds.Get(name));
+            if (function.ValueType != JavaScriptValueType.Function)
+            {
+                throw new InvalidOperationException(
+                    string.Format(
+                        CultureInfo.InvariantCulture,
+                        "Could not resolve '{0}' on the batched bridge.",
+                        name));
+            }
+
+            return function;
+        }
+
+        private GCHandle Pin(object value)
+        {
+            // Tracked as soon as it is allocated, so no failure can leak it.
+            var handle = GCHandle.Alloc(value, GCHandleType.Pinned);
+            try
+            {
+                _pinnedScripts.Add(handle);
+            }
+            catch
+            {
+                handle.Free();
+                throw;
+            }
+
+            return handle;
+        }
+
+        private void Unpin(GCHandle handle)
+        {
+            _pinnedScripts.Remove(handle);
+            handle.Free();
+        }
+
+        private JavaScriptValue MergeBatch(JavaScriptValue batch, JavaScriptValue next, ref bool isCopy)
+        {
+            if (next.ValueType != JavaScriptValueType.Array)
+            {
+                return batch;
+            }
+
+            // The merged batch is kept between calls, so it is referenced.
+            if (!batch.IsValid)
+            {
+                next.AddRef();
+                return next;
+            }
+
+            //
+            // The columns are concatenated in script, so the batch is still
+            // read in a single pass. The flushed queues belong to the
+            // script, so the first merge copies them into new arrays.
+            //
+            if (!isCopy)
+            {
+                var copy = JavaScriptValue.CreateArray(3);
+                for (var i = 0; i < 3; ++i)
+                {
+                    var column = JavaScriptValue.CreateArray(0);
+                    AppendColumn(column, batch.GetIndexedProperty(JavaScriptValue.FromInt32(i)));
+                    copy.SetIndexedProperty(JavaScriptValue.FromInt32(i), column);
+                }
+
+                copy.AddRef();
+                batch.Release();
+                batch = copy;
+                isCopy = true;
+            }
+
+            for (var i = 0; i < 3; ++i)
+            {
+                AppendColumn(
+                    batch.GetIndexedProperty(JavaScriptValue.FromInt32(i)),
+                    next.GetIndexedProperty(JavaScriptValue.FromInt32(i)));
+            }
+
+            return batch;
+        }
+
+        private void AppendColumn(JavaScriptValue column, JavaScriptValue items)
+        {
+            if (items.ValueType != JavaScriptValueType.Array)
+            {
+                return;
+            }
+
+            var length = ChakraMarshaler.GetLength(column, _propertyIds);
+            var count = ChakraMarshaler.GetLength(items, _propertyIds);
+            for (var i = 0; i < count; ++i)
+            {
+                column.SetIndexedProperty(
+                    JavaScriptValue.FromInt32(length + i),
+                    items.GetIndexedProperty(JavaScriptValue.FromInt32(i)));
+            }
+        }
+
+        private void ProcessResponse(JavaScriptValue response)
+        {
+            //
+            // The flushed queue is read in place, so native calls bind their
+            // arguments straight from the JavaScript values, rather than from
+            // a JSON string or a JSON tree built from the whole queue.
+            //
+            if (response.IsValid && response.ValueType == JavaScriptValueType.Array)
+            {
+                using (var reader = new ChakraJsonReader(response, _propertyIds))
+                {
+                    _callback.Invoke(reader);
+                }
+            }
         }
     }
 }
@@ -0,0 +1,59 @@
+﻿using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using System;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// A native method backed by invokers compiled ahead of time.
+    /// </summary>
+    /// <remarks>
+    /// The invokers call the module method directly and bind their
+    /// arguments with <see cref="NativeArguments"/>, so no reflection or
+    /// expression compilation happens at runtime. Projects that import
+    /// <c>ReactNative.Build.targets</c> get them generated for each partial
+    /// module; other modules can write them by hand.
+    /// </remarks>
+    public sealed class GeneratedNativeMethod : INativeMethod
+    {
+        private readonly Action<ICatalystInstance, JArray> _invoke;
+        private readonly Action<ICatalystInstance, JsonReader> _readerInvoke;
+
+        /// <summary>
+        /// Instantiates the <see cref="GeneratedNativeMethod"/>.
+        /// </summary>
+        /// <param name="type">The method type.</param>
+        /// <param name="invoke">Invokes the method with a JSON array of arguments.</param>
+        /// <param name="readerInvoke">
+        /// Invokes the method with a reader positioned before the arguments.
+        /// </param>
+        public GeneratedNativeMethod(
+            string type,
+            Action<ICatalystInstance, JArray> invoke,
+            Action<ICatalystInstance, JsonReader> readerInvoke)
+        {
+            if (type == null)
+                throw new ArgumentNullException(nameof(type));
+            if (invoke == null)
+                throw new ArgumentNullException(nameof(invoke));
+            if (readerInvoke == null)
+                throw new ArgumentNullException(nameof(readerInvoke));
+
+            Type = type;
+            _invoke = invoke;
+            _readerInvoke = readerInvoke;
+        }
+
+        public string Type { get; }
+
+        public void Invoke(ICatalystInstance instance, JArray parameters)
+        {
+            _invoke(instance, parameters);
+        }
+
+        public void Invoke(ICatalystInstance instance, JsonReader reader)
+        {
+            _readerInvoke(instance, reader);
+        }
+    }
+}
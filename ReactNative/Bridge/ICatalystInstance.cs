@@ -10,6 +10,16 @@ namespace ReactNative.Bridge
 
         void InvokeCallback(int callbackId, JArray arguments);
 
+        void InvokeCallback(int callbackId, object[] arguments);
+
+        /// <summary>
+        /// Invokes several callbacks, and runs the native calls they queue
+        /// as one batch.
+        /// </summary>
+        /// <param name="callbackIds">The callback IDs.</param>
+        /// <param name="argumentsList">The arguments for each callback.</param>
+        void InvokeCallbacks(IList<int> callbackIds, IList<object[]> argumentsList);
+
         void Initialize();
 
         T GetNativeModule<T>(Type nativeModuleInterface) where T : INativeModule;
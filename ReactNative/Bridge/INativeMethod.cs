@@ -1,4 +1,5 @@
-﻿using Newtonsoft.Json.Linq;
+﻿using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
 
 namespace ReactNative.Bridge
 {
@@ -7,5 +8,17 @@ namespace ReactNative.Bridge
         string Type { get; }
 
         void Invoke(ICatalystInstance instance, JArray parameters);
+
+        /// <summary>
+        /// Invokes the method with arguments read directly from the reader.
+        /// </summary>
+        /// <remarks>
+        /// The reader must be positioned on the <see cref="JsonToken.StartArray"/>
+        /// token of the arguments, and is left on the matching
+        /// <see cref="JsonToken.EndArray"/> token.
+        /// </remarks>
+        /// <param name="instance">The catalyst instance.</param>
+        /// <param name="reader">The argument reader.</param>
+        void Invoke(ICatalystInstance instance, JsonReader reader);
     }
 }
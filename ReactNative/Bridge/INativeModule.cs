@@ -1,4 +1,5 @@
-﻿using System.Collections.Generic;
+﻿using ReactNative.Bridge.Queue;
+using System.Collections.Generic;
 
 namespace ReactNative.Bridge
 {
@@ -8,8 +9,30 @@ namespace ReactNative.Bridge
 
         IReadOnlyDictionary<string, object> Constants { get; }
 
+        /// <summary>
+        /// Whether the constants only change with the version of the
+        /// application.
+        /// </summary>
+        /// <remarks>
+        /// Stable constants are created once and stored in the
+        /// <see cref="NativeModuleConstantsCache"/>, if the registry has
+        /// one, rather than created at every start.
+        /// </remarks>
+        bool HasStableConstants { get; }
+
         IReadOnlyDictionary<string, INativeMethod> Methods { get; }
 
+        /// <summary>
+        /// The queue the module's methods run on.
+        /// </summary>
+        /// <remarks>
+        /// If <b>null</b>, methods run on the native modules thread in the
+        /// order they appear in each batch. Otherwise, calls to the module
+        /// keep their order on this queue, in parallel with other modules.
+        /// Modules may share a queue.
+        /// </remarks>
+        IMessageQueueThread ActionQueue { get; }
+
         string Name { get; }
 
         void Initialize();
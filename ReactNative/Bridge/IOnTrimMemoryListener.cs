@@ -0,0 +1,16 @@
+﻿namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// A native module that can release cached memory when asked to.
+    /// </summary>
+    /// <remarks>
+    /// Listeners are notified before the JavaScript heap is collected. A
+    /// module with an <see cref="INativeModule.ActionQueue"/> is notified
+    /// on that queue; other modules are notified on the JavaScript thread
+    /// and must not call into JavaScript.
+    /// </remarks>
+    public interface IOnTrimMemoryListener
+    {
+        void OnTrimMemory();
+    }
+}
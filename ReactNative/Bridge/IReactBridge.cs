@@ -1,4 +1,6 @@
 ﻿using Newtonsoft.Json.Linq;
+using System;
+using System.Collections.Generic;
 
 namespace ReactNative.Bridge
 {
@@ -6,8 +8,61 @@ namespace ReactNative.Bridge
     {
         void CallFunction(int moduleId, int methodId, JArray arguments);
 
+        void CallFunction(int moduleId, int methodId, object[] arguments);
+
+        void CallFunctions(int moduleId, int methodId, IList<object[]> argumentsList);
+
         void InvokeCallback(int callbackID, JArray arguments);
 
+        void InvokeCallback(int callbackID, object[] arguments);
+
+        void InvokeCallbacks(IList<int> callbackIDs, IList<object[]> argumentsList);
+
         void SetGlobalVariable(string propertyName, string jsonEncodedArgument);
+
+        void SetGlobalVariable(string propertyName, JToken value);
+
+        /// <summary>
+        /// Sets a global object whose properties are only resolved, and
+        /// converted to JavaScript values, when they are first read.
+        /// </summary>
+        /// <param name="propertyName">The global variable name.</param>
+        /// <param name="properties">The property resolvers.</param>
+        void SetLazyGlobalVariable(string propertyName, IReadOnlyDictionary<string, Func<JToken>> properties);
+
+        /// <summary>
+        /// Sets a global function that calls into native code.
+        /// </summary>
+        /// <remarks>
+        /// The function runs synchronously on the JavaScript thread and
+        /// returns <c>undefined</c>. Exceptions it throws are raised in
+        /// JavaScript.
+        /// </remarks>
+        /// <param name="propertyName">The global variable name.</param>
+        /// <param name="function">The native function.</param>
+        void SetGlobalFunction(string propertyName, Action<JArray> function);
+
+        void RunScript(string script, string sourceUrl);
+
+        void RunScript(string script, byte[] serializedScript, string sourceUrl);
+
+        void RunScript(IntPtr script, IntPtr serializedScript, string sourceUrl);
+
+        /// <summary>
+        /// Parses a script without running it.
+        /// </summary>
+        /// <param name="script">The script.</param>
+        /// <param name="sourceUrl">The source URL.</param>
+        /// <returns>
+        /// An action that runs the parsed script once on the JavaScript
+        /// thread, in the context it was parsed in.
+        /// </returns>
+        Action ParseScript(string script, string sourceUrl);
+
+        Action ParseScript(string script, byte[] serializedScript, string sourceUrl);
+
+        Action ParseScript(IntPtr script, IntPtr serializedScript, string sourceUrl);
+
+        byte[] SerializeScript(string script);
     }
 }
@@ -0,0 +1,17 @@
+﻿using Newtonsoft.Json;
+
+namespace ReactNative.Bridge
+{
+    public interface IReactCallback
+    {
+        /// <summary>
+        /// Invokes the native calls flushed from JavaScript.
+        /// </summary>
+        /// <remarks>
+        /// Called on the JavaScript thread. The reader walks the flushed queue
+        /// in place, so it is only valid until this method returns.
+        /// </remarks>
+        /// <param name="batch">The reader over the batch.</param>
+        void Invoke(JsonReader batch);
+    }
+}
@@ -0,0 +1,560 @@
+﻿using Newtonsoft.Json.Linq;
+using ReactNative.Hosting;
+using ReactNative.Tracing;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics.Tracing;
+using System.Globalization;
+using System.IO;
+using System.Text;
+using System.Threading.Tasks;
+using Windows.Security.Cryptography;
+using Windows.Security.Cryptography.Core;
+using Windows.Storage;
+using Windows.Storage.Streams;
+using Windows.System.Profile;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// A class that stores JavaScript bundle information and allows the
+    /// <see cref="IReactBridge"/> to load a correct bundle.
+    /// </summary>
+    /// <remarks>
+    /// The bridge may keep referring to memory owned by the loader, so the
+    /// loader must only be disposed after the JavaScript runtime.
+    /// </remarks>
+    public abstract class JavaScriptBundleLoader : IDisposable
+    {
+        /// <summary>
+        /// The source URL of the bundle.
+        /// </summary>
+        public abstract string SourceUrl { get; }
+
+        /// <summary>
+        /// Reads the bundle, and any cached data for it, off the JavaScript
+        /// thread.
+        /// </summary>
+        /// <returns>A task to await initialization.</returns>
+        public abstract Task InitializeAsync();
+
+        /// <summary>
+        /// Loads the bundle into the bridge.
+        /// </summary>
+        /// <remarks>
+        /// Must be called on the JavaScript thread after
+        /// <see cref="InitializeAsync"/> has completed.
+        /// </remarks>
+        /// <param name="bridge">The bridge.</param>
+        public abstract void LoadScript(IReactBridge bridge);
+
+        /// <summary>
+        /// Parses, or deserializes, the bundle into the bridge without
+        /// running it.
+        /// </summary>
+        /// <remarks>
+        /// Must be called on the JavaScript thread after
+        /// <see cref="InitializeAsync"/> has completed. Parsing does not
+        /// depend on any native modules, so it can overlap with building
+        /// the module registry. Loaders that cannot parse ahead defer all
+        /// of their work to the returned action.
+        /// </remarks>
+        /// <param name="bridge">The bridge.</param>
+        /// <returns>
+        /// An action to run the bundle on the JavaScript thread, once the
+        /// bridge has been configured.
+        /// </returns>
+        public virtual Action ParseScript(IReactBridge bridge)
+        {
+            if (bridge == null)
+                throw new ArgumentNullException(nameof(bridge));
+
+            return () => LoadScript(bridge);
+        }
+
+        /// <summary>
+        /// Releases any memory held on behalf of the JavaScript runtime.
+        /// </summary>
+        public virtual void Dispose()
+        {
+        }
+
+        /// <summary>
+        /// Creates a loader that parses the bundle from a file on every load.
+        /// </summary>
+        /// <param name="fileName">The file name, e.g., an <c>ms-appx:</c> URI.</param>
+        /// <returns>The loader.</returns>
+        public static JavaScriptBundleLoader CreateFileLoader(string fileName)
+        {
+            if (fileName == null)
+                throw new ArgumentNullException(nameof(fileName));
+
+            return new FileJavaScriptBundleLoader(fileName);
+        }
+
+        /// <summary>
+        /// Creates a loader that keeps a serialized copy of the parsed bundle
+        /// in local app storage, and runs from that copy on later loads.
+        /// </summary>
+        /// <remarks>
+        /// Cached copies are memory-mapped and passed to Chakra without being
+        /// copied into the managed heap.
+        /// </remarks>
+        /// <param name="fileName">The file name, e.g., an <c>ms-appx:</c> URI.</param>
+        /// <returns>The loader.</returns>
+        public static JavaScriptBundleLoader CreateCachedFileLoader(string fileName)
+        {
+            if (fileName == null)
+                throw new ArgumentNullException(nameof(fileName));
+
+            return new CachedFileJavaScriptBundleLoader(fileName);
+        }
+
+        /// <summary>
+        /// Creates a loader for a bundle split into segments, which only
+        /// runs the startup segment when loaded and runs other segments the
+        /// first time JavaScript requires them.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// The index file is a JSON object with a <c>startup</c> segment and
+        /// a <c>segments</c> object keyed by segment ID. A segment is either
+        /// the path of a UTF-8 source file, which is parsed on demand, or an
+        /// object with the paths of a null-terminated UTF-16 <c>script</c>
+        /// and its <c>serializedScript</c>, which are memory-mapped. If the
+        /// runtime rejects the serialized script, the source is parsed
+        /// instead. Paths are relative to the index file.
+        /// </para>
+        /// <para>
+        /// Before the startup segment runs, the loader sets a global
+        /// <c>nativeRequireSegment(id)</c> function, which runs the segment
+        /// with the given ID unless it has already run in that context.
+        /// Each segment gets its own source context.
+        /// </para>
+        /// </remarks>
+        /// <param name="indexFileName">
+        /// The index file name, e.g., an <c>ms-appx:</c> URI.
+        /// </param>
+        /// <returns>The loader.</returns>
+        public static JavaScriptBundleLoader CreateSegmentedFileLoader(string indexFileName)
+        {
+            if (indexFileName == null)
+                throw new ArgumentNullException(nameof(indexFileName));
+
+            return new SegmentedFileJavaScriptBundleLoader(indexFileName);
+        }
+
+        private static void OnCacheFailed(string cacheName, Exception exception)
+        {
+            if (ReactEventSource.Log.IsEnabled(EventLevel.Warning, ReactEventSource.Keywords.Cache))
+            {
+                ReactEventSource.Log.CacheFailed(cacheName, exception.ToString());
+            }
+        }
+
+        private static async Task<IBuffer> ReadBundleAsync(string fileName)
+        {
+            var storageFile = await StorageFile.GetFileFromApplicationUriAsync(new Uri(fileName));
+            return await FileIO.ReadBufferAsync(storageFile);
+        }
+
+        class FileJavaScriptBundleLoader : JavaScriptBundleLoader
+        {
+            private string _script;
+
+            public FileJavaScriptBundleLoader(string fileName)
+            {
+                SourceUrl = fileName;
+            }
+
+            public override string SourceUrl { get; }
+
+            public override async Task InitializeAsync()
+            {
+                var buffer = await ReadBundleAsync(SourceUrl);
+                _script = CryptographicBuffer.ConvertBinaryToString(BinaryStringEncoding.Utf8, buffer);
+            }
+
+            public override void LoadScript(IReactBridge bridge)
+            {
+                if (bridge == null)
+                    throw new ArgumentNullException(nameof(bridge));
+                if (_script == null)
+                    throw new InvalidOperationException("Bundle loader has not been initialized.");
+
+                bridge.RunScript(_script, SourceUrl);
+            }
+
+            public override Action ParseScript(IReactBridge bridge)
+            {
+                if (bridge == null)
+                    throw new ArgumentNullException(nameof(bridge));
+                if (_script == null)
+                    throw new InvalidOperationException("Bundle loader has not been initialized.");
+
+                return bridge.ParseScript(_script, SourceUrl);
+            }
+        }
+
+        class CachedFileJavaScriptBundleLoader : JavaScriptBundleLoader
+        {
+            private const string CacheFolderName = "ReactNative";
+            private const string ScriptExtension = ".js";
+            private const string SerializedScriptExtension = ".bin";
+
+            private IBuffer _bundle;
+            private string _cacheName;
+            private MappedFile _mappedScript;
+            private MappedFile _mappedSerializedScript;
+
+            // Kept after the cache is regenerated, so later loads into other
+            // contexts also run bytecode.
+            private string _script;
+            private byte[] _serializedScript;
+
+            public CachedFileJavaScriptBundleLoader(string fileName)
+            {
+                SourceUrl = fileName;
+            }
+
+            public override string SourceUrl { get; }
+
+            public override async Task InitializeAsync()
+            {
+                // The bundle stays in the native buffer returned by WinRT; it
+                // is only decoded to a managed string if the cache is unusable.
+                _bundle = await ReadBundleAsync(SourceUrl);
+                _cacheName = GetCacheName(_bundle);
+
+                var cacheFolder = await GetCacheFolderAsync();
+                var scriptFile = await cacheFolder.TryGetItemAsync(_cacheName + ScriptExtension) as StorageFile;
+                var serializedScriptFile = await cacheFolder.TryGetItemAsync(_cacheName + SerializedScriptExtension) as StorageFile;
+                if (scriptFile != null && serializedScriptFile != null)
+                {
+                    try
+                    {
+                        _mappedScript = MappedFile.OpenScript(scriptFile.Path);
+                        _mappedSerializedScript = MappedFile.Open(serializedScriptFile.Path);
+                    }
+                    catch (IOException ex)
+                    {
+                        OnCacheFailed(_cacheName, ex);
+                        DisposeMappedFiles();
+                    }
+                }
+            }
+
+            public override void LoadScript(IReactBridge bridge)
+            {
+                ParseScript(bridge)();
+            }
+
+            public override Action ParseScript(IReactBridge bridge)
+            {
+                if (bridge == null)
+                    throw new ArgumentNullException(nameof(bridge));
+                if (_bundle == null)
+                    throw new InvalidOperationException("Bundle loader has not been initialized.");
+
+                if (_mappedScript != null)
+                {
+                    try
+                    {
+                        return bridge.ParseScript(_mappedScript.Pointer, _mappedSerializedScript.Pointer, SourceUrl);
+                    }
+                    catch (JavaScriptUsageException ex)
+                    when (ex.ErrorCode == JavaScriptErrorCode.BadSerializedScript)
+                    {
+                        // The cache was written by an incompatible runtime or
+                        // is corrupt, so regenerate it below.
+                        DisposeMappedFiles();
+                    }
+                }
+
+                if (_serializedScript != null)
+                {
+                    return bridge.ParseScript(_script, _serializedScript, SourceUrl);
+                }
+
+                var script = CryptographicBuffer.ConvertBinaryToString(BinaryStringEncoding.Utf8, _bundle);
+                var serializedScript = default(byte[]);
+                try
+                {
+                    serializedScript = bridge.SerializeScript(script);
+                }
+                catch (JavaScriptUsageException ex)
+                when (ex.ErrorCode == JavaScriptErrorCode.CannotSerializeDebugScript)
+                {
+                    return bridge.ParseScript(script, SourceUrl);
+                }
+
+                // Serializing already parsed the bundle, so use the serialized
+                // form rather than parsing the source a second time.
+                var run = bridge.ParseScript(script, serializedScript, SourceUrl);
+                _script = script;
+                _serializedScript = serializedScript;
+
+                var cacheName = _cacheName;
+                SaveCacheAsync(cacheName, script, serializedScript).ContinueWith(
+                    task => OnCacheFailed(cacheName, task.Exception.GetBaseException()),
+                    TaskContinuationOptions.OnlyOnFaulted);
+
+                return run;
+            }
+
+            public override void Dispose()
+            {
+                DisposeMappedFiles();
+            }
+
+            private void DisposeMappedFiles()
+            {
+                _mappedScript?.Dispose();
+                _mappedScript = null;
+                _mappedSerializedScript?.Dispose();
+                _mappedSerializedScript = null;
+            }
+
+            private static async Task SaveCacheAsync(string cacheName, string script, byte[] serializedScript)
+            {
+                var cacheFolder = await GetCacheFolderAsync();
+
+                //
+                // The source is stored as null-terminated UTF-16 so a mapped
+                // view of the file can be passed to Chakra as-is. Each file
+                // only appears once it is complete, and the source goes
+                // first, since a source without bytecode is ignored.
+                //
+                await cacheFolder.ReplaceFileAsync(
+                    cacheName + ScriptExtension,
+                    file => FileIO.WriteBytesAsync(file, Encoding.Unicode.GetBytes(script + '\0')).AsTask());
+
+                await cacheFolder.ReplaceFileAsync(
+                    cacheName + SerializedScriptExtension,
+                    file => FileIO.WriteBytesAsync(file, serializedScript).AsTask());
+            }
+
+            private static async Task<StorageFolder> GetCacheFolderAsync()
+            {
+                return await ApplicationData.Current.LocalCacheFolder.CreateFolderAsync(
+                    CacheFolderName,
+                    CreationCollisionOption.OpenIfExists);
+            }
+
+            private static string GetCacheName(IBuffer bundle)
+            {
+                //
+                // Chakra ships with the OS, so the serialized format is keyed
+                // by the OS version and the runtime version in addition to
+                // the bundle contents.
+                //
+                var runtimeVersion = CryptographicBuffer.ConvertStringToBinary(
+                    AnalyticsInfo.VersionInfo.DeviceFamilyVersion + "|" + JavaScriptRuntimeVersion.Version11,
+                    BinaryStringEncoding.Utf8);
+
+                var hash = HashAlgorithmProvider.OpenAlgorithm(HashAlgorithmNames.Sha256).CreateHash();
+                hash.Append(bundle);
+                hash.Append(runtimeVersion);
+                return CryptographicBuffer.EncodeToHexString(hash.GetValueAndReset());
+            }
+        }
+
+        class SegmentedFileJavaScriptBundleLoader : JavaScriptBundleLoader
+        {
+            private const string RequireSegmentName = "nativeRequireSegment";
+
+            private readonly Dictionary<string, Segment> _segments = new Dictionary<string, Segment>();
+
+            private Segment _startupSegment;
+
+            public SegmentedFileJavaScriptBundleLoader(string indexFileName)
+            {
+                SourceUrl = indexFileName;
+            }
+
+            public override string SourceUrl { get; }
+
+            public override async Task InitializeAsync()
+            {
+                var indexFile = await StorageFile.GetFileFromApplicationUriAsync(new Uri(SourceUrl));
+                var index = JObject.Parse(await FileIO.ReadTextAsync(indexFile));
+                var directory = Path.GetDirectoryName(indexFile.Path);
+
+                var segments = index["segments"] as JObject;
+                if (segments != null)
+                {
+                    foreach (var property in segments.Properties())
+                    {
+                        _segments.Add(property.Name, CreateSegment(directory, property.Value));
+                    }
+                }
+
+                _startupSegment = CreateSegment(directory, index["startup"]);
+            }
+
+            public override void LoadScript(IReactBridge bridge)
+            {
+                ParseScript(bridge)();
+            }
+
+            public override Action ParseScript(IReactBridge bridge)
+            {
+                if (bridge == null)
+                    throw new ArgumentNullException(nameof(bridge));
+                if (_startupSegment == null)
+                    throw new InvalidOperationException("Bundle loader has not been initialized.");
+
+                // Segments run once per context, so each bridge tracks its own.
+                var loadedSegments = new HashSet<string>();
+                bridge.SetGlobalFunction(RequireSegmentName, arguments => RequireSegment(bridge, loadedSegments, arguments));
+                return _startupSegment.Parse(bridge);
+            }
+
+            public override void Dispose()
+            {
+                _startupSegment?.Dispose();
+                foreach (var segment in _segments.Values)
+                {
+                    segment.Dispose();
+                }
+            }
+
+            private void RequireSegment(IReactBridge bridge, HashSet<string> loadedSegments, JArray arguments)
+            {
+                var id = arguments.Count > 0 ? arguments[0].Value<string>() : null;
+                var segment = default(Segment);
+                if (id == null || !_segments.TryGetValue(id, out segment))
+                {
+                    throw new ArgumentException(
+                        string.Format(
+                            CultureInfo.InvariantCulture,
+                            "Unknown bundle segment '{0}'.",
+                            id));
+                }
+
+                if (loadedSegments.Add(id))
+                {
+                    try
+                    {
+                        segment.Parse(bridge)();
+                    }
+                    catch
+                    {
+                        // Let a later require retry the segment.
+                        loadedSegments.Remove(id);
+                        throw;
+                    }
+                }
+            }
+
+            private Segment CreateSegment(string directory, JToken entry)
+            {
+                var source = entry as JValue;
+                if (source != null && source.Type == JTokenType.String)
+                {
+                    return new Segment(GetSegmentUrl((string)source), Path.Combine(directory, (string)source), null);
+                }
+
+                var serialized = entry as JObject;
+                var script = serialized?.Value<string>("script");
+                var serializedScript = serialized?.Value<string>("serializedScript");
+                if (script == null || serializedScript == null)
+                {
+                    throw new InvalidOperationException(
+                        string.Format(
+                            CultureInfo.InvariantCulture,
+                            "Invalid segment '{0}' in bundle index '{1}'.",
+                            entry,
+                            SourceUrl));
+                }
+
+                return new Segment(GetSegmentUrl(script), Path.Combine(directory, script), Path.Combine(directory, serializedScript));
+            }
+
+            private string GetSegmentUrl(string path)
+            {
+                return new Uri(new Uri(SourceUrl), path).ToString();
+            }
+
+            class Segment : IDisposable
+            {
+                private readonly string _sourceUrl;
+                private readonly string _scriptPath;
+                private readonly string _serializedScriptPath;
+
+                private MappedFile _mappedScript;
+                private MappedFile _mappedSerializedScript;
+
+                // Set once the serialized script has been rejected, so later
+                // contexts parse the source without trying it again.
+                private string _fallbackScript;
+
+                public Segment(string sourceUrl, string scriptPath, string serializedScriptPath)
+                {
+                    _sourceUrl = sourceUrl;
+                    _scriptPath = scriptPath;
+                    _serializedScriptPath = serializedScriptPath;
+                }
+
+                public Action Parse(IReactBridge bridge)
+                {
+                    if (_serializedScriptPath == null)
+                    {
+                        return bridge.ParseScript(File.ReadAllText(_scriptPath), _sourceUrl);
+                    }
+
+                    if (_fallbackScript != null)
+                    {
+                        return bridge.ParseScript(_fallbackScript, _sourceUrl);
+                    }
+
+                    //
+                    // The mapped views are shared by every context the segment
+                    // runs in, and stay open until the loader is disposed,
+                    // which happens after the runtime.
+                    //
+                    if (_mappedScript == null)
+                    {
+                        var mappedScript = MappedFile.OpenScript(_scriptPath);
+                        try
+                        {
+                            _mappedSerializedScript = MappedFile.Open(_serializedScriptPath);
+                        }
+                        catch
+                        {
+                            mappedScript.Dispose();
+                            throw;
+                        }
+
+                        _mappedScript = mappedScript;
+                    }
+
+                    try
+                    {
+                        return bridge.ParseScript(_mappedScript.Pointer, _mappedSerializedScript.Pointer, _sourceUrl);
+                    }
+                    catch (JavaScriptUsageException ex)
+                    when (ex.ErrorCode == JavaScriptErrorCode.BadSerializedScript)
+                    {
+                        //
+                        // The serialized script was written by an incompatible
+                        // runtime or is corrupt, so parse the UTF-16 source
+                        // next to it instead, as the cached loader does.
+                        //
+                        OnCacheFailed(_sourceUrl, ex);
+                        _fallbackScript = Encoding.Unicode.GetString(File.ReadAllBytes(_scriptPath)).TrimEnd('\0');
+                        return bridge.ParseScript(_fallbackScript, _sourceUrl);
+                    }
+                }
+
+                public void Dispose()
+                {
+                    _mappedScript?.Dispose();
+                    _mappedScript = null;
+                    _mappedSerializedScript?.Dispose();
+                    _mappedSerializedScript = null;
+                }
+            }
+        }
+    }
+}
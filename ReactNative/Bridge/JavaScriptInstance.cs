@@ -0,0 +1,185 @@
+﻿using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using ReactNative.Bridge.Queue;
+using ReactNative.Hosting;
+using System;
+using System.Collections.Generic;
+using System.Threading.Tasks;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// An isolated JavaScript context, with the core bundle loaded, that
+    /// shares its runtime and thread with the other instances of its
+    /// <see cref="JavaScriptInstancePool"/>.
+    /// </summary>
+    public sealed class JavaScriptInstance : IDisposable
+    {
+        private readonly JavaScriptInstancePool _pool;
+        private readonly JavaScriptContext _context;
+        private readonly ChakraReactBridge _bridge;
+        private readonly DeferredReactCallback _callback;
+
+        private bool _disposed;
+
+        internal JavaScriptInstance(IMessageQueueThread jsQueueThread, JavaScriptInstancePool pool, JavaScriptContext context, ChakraReactBridge bridge, DeferredReactCallback callback)
+        {
+            _pool = pool;
+            _context = context;
+            _bridge = bridge;
+            _callback = callback;
+            JSQueueThread = new ContextMessageQueueThread(jsQueueThread, context);
+        }
+
+        /// <summary>
+        /// The queue for the instance, which runs each action on the shared
+        /// JavaScript thread with the instance's context active.
+        /// </summary>
+        public IMessageQueueThread JSQueueThread { get; }
+
+        /// <summary>
+        /// The bridge to the instance's context.
+        /// </summary>
+        /// <remarks>
+        /// Must only be used from <see cref="JSQueueThread"/>.
+        /// </remarks>
+        public IReactBridge Bridge
+        {
+            get
+            {
+                return _bridge;
+            }
+        }
+
+        /// <summary>
+        /// Releases the instance's bridge and context.
+        /// </summary>
+        /// <remarks>
+        /// Must be called before the JavaScript thread is disposed.
+        /// </remarks>
+        public void Dispose()
+        {
+            if (_disposed)
+            {
+                return;
+            }
+
+            _disposed = true;
+            _pool.Remove(this);
+            JSQueueThread.RunOnQueue(() =>
+            {
+                _bridge.Dispose();
+                _context.Release();
+            });
+        }
+
+        internal void Bind(IReactCallback callback)
+        {
+            JSQueueThread.RunOnQueue(() => _callback.Bind(callback), MessageQueuePriority.Immediate);
+        }
+
+        class ContextMessageQueueThread : IMessageQueueThread
+        {
+            private readonly IMessageQueueThread _jsQueueThread;
+            private readonly JavaScriptContext _context;
+
+            public ContextMessageQueueThread(IMessageQueueThread jsQueueThread, JavaScriptContext context)
+            {
+                _jsQueueThread = jsQueueThread;
+                _context = context;
+            }
+
+            public void RunOnQueue(Action action)
+            {
+                RunOnQueue(action, MessageQueuePriority.Normal);
+            }
+
+            public void RunOnQueue(Action action, MessageQueuePriority priority)
+            {
+                if (action == null)
+                    throw new ArgumentNullException(nameof(action));
+
+                _jsQueueThread.RunOnQueue(
+                    () =>
+                    {
+                        using (new JavaScriptContext.Scope(_context))
+                        {
+                            action();
+                        }
+                    },
+                    priority);
+            }
+
+            public Task<T> CallOnQueue<T>(Func<T> func)
+            {
+                return CallOnQueue(func, MessageQueuePriority.Normal);
+            }
+
+            public Task<T> CallOnQueue<T>(Func<T> func, MessageQueuePriority priority)
+            {
+                if (func == null)
+                    throw new ArgumentNullException(nameof(func));
+
+                return _jsQueueThread.CallOnQueue(
+                    () =>
+                    {
+                        using (new JavaScriptContext.Scope(_context))
+                        {
+                            return func();
+                        }
+                    },
+                    priority);
+            }
+
+            public bool IsOnThread()
+            {
+                return _jsQueueThread.IsOnThread();
+            }
+        }
+
+        /// <summary>
+        /// Holds the native calls flushed while the core bundle is loaded,
+        /// until the instance is acquired and has somewhere to send them.
+        /// </summary>
+        /// <remarks>
+        /// Only used on the JavaScript thread.
+        /// </remarks>
+        internal sealed class DeferredReactCallback : IReactCallback
+        {
+            private List<JArray> _pendingBatches;
+            private IReactCallback _target;
+
+            public void Invoke(JsonReader batch)
+            {
+                if (_target != null)
+                {
+                    _target.Invoke(batch);
+                    return;
+                }
+
+                if (_pendingBatches == null)
+                {
+                    _pendingBatches = new List<JArray>();
+                }
+
+                // The reader does not outlive the call, so the batch is loaded.
+                _pendingBatches.Add(JArray.Load(batch));
+            }
+
+            public void Bind(IReactCallback target)
+            {
+                _target = target;
+
+                var pendingBatches = _pendingBatches;
+                _pendingBatches = null;
+                if (pendingBatches != null)
+                {
+                    foreach (var batch in pendingBatches)
+                    {
+                        target.Invoke(batch.CreateReader());
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,227 @@
+﻿using ReactNative.Bridge.Queue;
+using ReactNative.Hosting;
+using System;
+using System.Collections.Generic;
+using System.Threading.Tasks;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// Creates <see cref="JavaScriptInstance"/>s that share one JavaScript
+    /// thread and runtime, and keeps warm instances ready to be acquired.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each instance gets its own context, so its globals are isolated
+    /// from those of other instances. Creating a context is much cheaper
+    /// than creating a runtime, and with a cached bundle loader, loading
+    /// the core bundle runs bytecode instead of parsing the source.
+    /// </para>
+    /// <para>
+    /// The core bundle is loaded before the instance's native modules are
+    /// known, so it must only read the module configuration lazily. Native
+    /// calls it flushes while loading are held until the instance is
+    /// acquired.
+    /// </para>
+    /// <para>
+    /// Each instance owns its bridge and releases it when disposed. Like
+    /// the instances, the pool must be disposed before the JavaScript
+    /// thread, so that it can dispose the instances that are still alive.
+    /// </para>
+    /// </remarks>
+    public sealed class JavaScriptInstancePool : IDisposable
+    {
+        private readonly IMessageQueueThread _jsQueueThread;
+        private readonly JavaScriptBundleLoader _coreBundleLoader;
+        private readonly object _gate = new object();
+        private readonly Queue<Task<JavaScriptInstance>> _warmInstances = new Queue<Task<JavaScriptInstance>>();
+        private readonly List<JavaScriptInstance> _instances = new List<JavaScriptInstance>();
+
+        private Task _initializeTask;
+        private bool _disposed;
+
+        /// <summary>
+        /// Instantiates the <see cref="JavaScriptInstancePool"/>.
+        /// </summary>
+        /// <param name="jsQueueThread">The JavaScript thread.</param>
+        /// <param name="coreBundleLoader">The loader for the core bundle.</param>
+        /// <param name="capacity">The number of warm instances to keep.</param>
+        public JavaScriptInstancePool(IMessageQueueThread jsQueueThread, JavaScriptBundleLoader coreBundleLoader, int capacity)
+        {
+            if (jsQueueThread == null)
+                throw new ArgumentNullException(nameof(jsQueueThread));
+            if (coreBundleLoader == null)
+                throw new ArgumentNullException(nameof(coreBundleLoader));
+            if (capacity < 0)
+                throw new ArgumentOutOfRangeException(nameof(capacity));
+
+            _jsQueueThread = jsQueueThread;
+            _coreBundleLoader = coreBundleLoader;
+            Capacity = capacity;
+        }
+
+        /// <summary>
+        /// The number of warm instances to keep.
+        /// </summary>
+        public int Capacity { get; }
+
+        /// <summary>
+        /// Starts warming instances until the pool is at capacity.
+        /// </summary>
+        /// <remarks>
+        /// Warm instances are created in the idle lane, so they do not hold
+        /// up work for instances that are already running.
+        /// </remarks>
+        public void Warm()
+        {
+            lock (_gate)
+            {
+                while (!_disposed && _warmInstances.Count < Capacity)
+                {
+                    _warmInstances.Enqueue(CreateInstanceAsync(MessageQueuePriority.Idle));
+                }
+            }
+        }
+
+        /// <summary>
+        /// Acquires a warm instance, or creates one if none is ready, and
+        /// starts warming its replacement.
+        /// </summary>
+        /// <param name="callback">The callback for native calls.</param>
+        /// <returns>The instance.</returns>
+        public async Task<JavaScriptInstance> AcquireAsync(IReactCallback callback)
+        {
+            if (callback == null)
+                throw new ArgumentNullException(nameof(callback));
+
+            var warmInstance = default(Task<JavaScriptInstance>);
+            lock (_gate)
+            {
+                if (_disposed)
+                {
+                    throw new ObjectDisposedException(nameof(JavaScriptInstancePool));
+                }
+
+                if (_warmInstances.Count > 0)
+                {
+                    warmInstance = _warmInstances.Dequeue();
+                }
+            }
+
+            var instance = await (warmInstance ?? CreateInstanceAsync(MessageQueuePriority.Normal));
+            instance.Bind(callback);
+            Warm();
+            return instance;
+        }
+
+        /// <summary>
+        /// Disposes the warm instances and any acquired instances that have
+        /// not been disposed yet.
+        /// </summary>
+        /// <remarks>
+        /// Must be called before the JavaScript thread is disposed. Instances
+        /// still being created are disposed as soon as they are ready.
+        /// </remarks>
+        public void Dispose()
+        {
+            var instances = default(JavaScriptInstance[]);
+            lock (_gate)
+            {
+                if (_disposed)
+                {
+                    return;
+                }
+
+                _disposed = true;
+                instances = _instances.ToArray();
+                _warmInstances.Clear();
+            }
+
+            foreach (var instance in instances)
+            {
+                instance.Dispose();
+            }
+        }
+
+        internal void Remove(JavaScriptInstance instance)
+        {
+            lock (_gate)
+            {
+                _instances.Remove(instance);
+            }
+        }
+
+        private Task EnsureInitializedAsync()
+        {
+            lock (_gate)
+            {
+                if (_initializeTask == null)
+                {
+                    _initializeTask = _coreBundleLoader.InitializeAsync();
+                }
+
+                return _initializeTask;
+            }
+        }
+
+        private async Task<JavaScriptInstance> CreateInstanceAsync(MessageQueuePriority priority)
+        {
+            await EnsureInitializedAsync();
+
+            // The task faults if the thread is disposed before the work runs.
+            return await _jsQueueThread.CallOnQueue<JavaScriptInstance>(CreateInstance, priority);
+        }
+
+        private JavaScriptInstance CreateInstance()
+        {
+            ThrowIfDisposed();
+
+            var context = JavaScriptContext.Current.Runtime.CreateContext();
+            context.AddRef();
+
+            var callback = new JavaScriptInstance.DeferredReactCallback();
+            var bridge = new ChakraReactBridge(callback);
+            try
+            {
+                using (new JavaScriptContext.Scope(context))
+                {
+                    _coreBundleLoader.LoadScript(bridge);
+                }
+
+                var instance = new JavaScriptInstance(_jsQueueThread, this, context, bridge, callback);
+                lock (_gate)
+                {
+                    // A pool disposed while the bundle loaded does not own it.
+                    if (!_disposed)
+                    {
+                        _instances.Add(instance);
+                        return instance;
+                    }
+                }
+
+                throw new ObjectDisposedException(nameof(JavaScriptInstancePool));
+            }
+            catch
+            {
+                using (new JavaScriptContext.Scope(context))
+                {
+                    bridge.Dispose();
+                }
+
+                context.Release();
+                throw;
+            }
+        }
+
+        private void ThrowIfDisposed()
+        {
+            lock (_gate)
+            {
+                if (_disposed)
+                {
+                    throw new ObjectDisposedException(nameof(JavaScriptInstancePool));
+                }
+            }
+        }
+    }
+}
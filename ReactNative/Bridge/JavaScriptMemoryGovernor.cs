@@ -0,0 +1,364 @@
+﻿using ReactNative.Bridge.Queue;
+using ReactNative.Hosting;
+using ReactNative.Tracing;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics.Tracing;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+using Windows.ApplicationModel;
+using Windows.ApplicationModel.Core;
+using Windows.System;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// Keeps the JavaScript heap within a budget, and trims it when the
+    /// application is suspended or the device is low on memory.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The budget is a soft limit. Once the heap grows past three quarters
+    /// of it, native modules are asked to drop their caches and the heap is
+    /// collected when the JavaScript thread is next idle. The runtime memory
+    /// limit is left unset, so script that briefly needs more than the
+    /// budget keeps running instead of failing with an out of memory error.
+    /// </para>
+    /// <para>
+    /// Suspended applications are terminated by their memory usage, and the
+    /// runtime only collects while script is running, so the heap is also
+    /// trimmed on suspend and when the OS reports memory pressure.
+    /// </para>
+    /// <para>
+    /// The governor must be disposed before the JavaScript thread.
+    /// </para>
+    /// </remarks>
+    public sealed class JavaScriptMemoryGovernor : IDisposable
+    {
+        private const string SuspendReason = "Suspend";
+        private const string LowMemoryReason = "LowMemory";
+        private const string BudgetReason = "Budget";
+        private const string AllocationFailureReason = "AllocationFailure";
+
+        private readonly IMessageQueueThread _jsQueueThread;
+        private readonly IList<IOnTrimMemoryListener> _trimMemoryListeners;
+
+        // The runtime only holds native pointers to the callbacks.
+        private readonly JavaScriptMemoryAllocationCallback _allocationCallback;
+        private readonly JavaScriptBeforeCollectCallback _beforeCollectCallback;
+
+        private JavaScriptRuntime _runtime;
+        private long _heapSize;
+        private long _peakHeapSize;
+        private long _collectionCount;
+        private long _trimCount;
+        private long _trimThreshold;
+        private int _trimPending;
+        private bool _started;
+
+        /// <summary>
+        /// Instantiates the <see cref="JavaScriptMemoryGovernor"/> with the
+        /// budget for this device.
+        /// </summary>
+        /// <param name="jsQueueThread">The JavaScript thread.</param>
+        /// <param name="modules">The native modules.</param>
+        public JavaScriptMemoryGovernor(IMessageQueueThread jsQueueThread, IEnumerable<INativeModule> modules)
+            : this(jsQueueThread, modules, GetDefaultBudget())
+        {
+        }
+
+        /// <summary>
+        /// Instantiates the <see cref="JavaScriptMemoryGovernor"/>.
+        /// </summary>
+        /// <param name="jsQueueThread">The JavaScript thread.</param>
+        /// <param name="modules">The native modules.</param>
+        /// <param name="budget">The heap budget, in bytes.</param>
+        public JavaScriptMemoryGovernor(IMessageQueueThread jsQueueThread, IEnumerable<INativeModule> modules, ulong budget)
+        {
+            if (jsQueueThread == null)
+                throw new ArgumentNullException(nameof(jsQueueThread));
+            if (modules == null)
+                throw new ArgumentNullException(nameof(modules));
+            if (budget == 0)
+                throw new ArgumentOutOfRangeException(nameof(budget));
+
+            _jsQueueThread = jsQueueThread;
+            _trimMemoryListeners = modules.OfType<IOnTrimMemoryListener>().ToList();
+            _allocationCallback = OnAllocation;
+            _beforeCollectCallback = OnBeforeCollect;
+            Budget = budget;
+        }
+
+        /// <summary>
+        /// The heap budget, in bytes.
+        /// </summary>
+        public ulong Budget { get; }
+
+        /// <summary>
+        /// The memory currently held by the runtime, in bytes.
+        /// </summary>
+        public long HeapSize
+        {
+            get
+            {
+                return Interlocked.Read(ref _heapSize);
+            }
+        }
+
+        /// <summary>
+        /// The most memory held by the runtime since the governor started,
+        /// in bytes.
+        /// </summary>
+        public long PeakHeapSize
+        {
+            get
+            {
+                return Interlocked.Read(ref _peakHeapSize);
+            }
+        }
+
+        /// <summary>
+        /// The number of collections run by the runtime, including those
+        /// requested by the governor.
+        /// </summary>
+        public long CollectionCount
+        {
+            get
+            {
+                return Interlocked.Read(ref _collectionCount);
+            }
+        }
+
+        /// <summary>
+        /// The number of times the heap has been trimmed.
+        /// </summary>
+        public long TrimCount
+        {
+            get
+            {
+                return Interlocked.Read(ref _trimCount);
+            }
+        }
+
+        /// <summary>
+        /// Attaches the governor to the runtime of the JavaScript thread and
+        /// starts listening for application memory events.
+        /// </summary>
+        public void Start()
+        {
+            if (_started)
+            {
+                throw new InvalidOperationException("Memory governor has already been started.");
+            }
+
+            _started = true;
+            _jsQueueThread.RunOnQueue(Attach, MessageQueuePriority.Immediate);
+
+            CoreApplication.Suspending += OnSuspending;
+            MemoryManager.AppMemoryUsageIncreased += OnAppMemoryUsageIncreased;
+            MemoryManager.AppMemoryUsageLimitChanging += OnAppMemoryUsageLimitChanging;
+        }
+
+        /// <summary>
+        /// Asks native modules to drop their caches, then collects the heap.
+        /// </summary>
+        /// <returns>A task to await the collection.</returns>
+        public Task TrimAsync()
+        {
+            return TrimAsync(LowMemoryReason);
+        }
+
+        public void Dispose()
+        {
+            if (!_started)
+            {
+                return;
+            }
+
+            CoreApplication.Suspending -= OnSuspending;
+            MemoryManager.AppMemoryUsageIncreased -= OnAppMemoryUsageIncreased;
+            MemoryManager.AppMemoryUsageLimitChanging -= OnAppMemoryUsageLimitChanging;
+
+            _jsQueueThread.RunOnQueue(Detach, MessageQueuePriority.Immediate);
+        }
+
+        private void Attach()
+        {
+            _runtime = JavaScriptContext.Current.Runtime;
+            _runtime.SetMemoryAllocationCallback(IntPtr.Zero, _allocationCallback);
+            _runtime.SetBeforeCollectCallback(IntPtr.Zero, _beforeCollectCallback);
+
+            var heapSize = (long)_runtime.MemoryUsage.ToUInt64();
+            Interlocked.Exchange(ref _heapSize, heapSize);
+            Interlocked.Exchange(ref _peakHeapSize, heapSize);
+            Interlocked.Exchange(ref _trimThreshold, (long)(Budget / 4 * 3));
+        }
+
+        private void Detach()
+        {
+            if (!_runtime.IsValid)
+            {
+                return;
+            }
+
+            _runtime.SetMemoryAllocationCallback(IntPtr.Zero, null);
+            _runtime.SetBeforeCollectCallback(IntPtr.Zero, null);
+            _runtime = default(JavaScriptRuntime);
+        }
+
+        private bool OnAllocation(IntPtr callbackState, JavaScriptMemoryEventType allocationEvent, UIntPtr allocationSize)
+        {
+            //
+            // The callback runs on the JavaScript thread in the middle of an
+            // allocation, so collections are only scheduled from here. Every
+            // allocation is allowed, and a failure only means the process
+            // itself is out of memory.
+            //
+            switch (allocationEvent)
+            {
+                case JavaScriptMemoryEventType.Allocate:
+                    var heapSize = Interlocked.Add(ref _heapSize, (long)allocationSize.ToUInt64());
+                    if (heapSize > Interlocked.Read(ref _peakHeapSize))
+                    {
+                        Interlocked.Exchange(ref _peakHeapSize, heapSize);
+                    }
+
+                    if (heapSize > Interlocked.Read(ref _trimThreshold))
+                    {
+                        ScheduleTrim(BudgetReason, MessageQueuePriority.Idle);
+                    }
+
+                    break;
+                case JavaScriptMemoryEventType.Free:
+                    Interlocked.Add(ref _heapSize, -(long)allocationSize.ToUInt64());
+                    break;
+                case JavaScriptMemoryEventType.Failure:
+                    // The failed allocation was already counted by its
+                    // Allocate event, and will not be followed by a Free.
+                    Interlocked.Add(ref _heapSize, -(long)allocationSize.ToUInt64());
+                    ScheduleTrim(AllocationFailureReason, MessageQueuePriority.Immediate);
+                    break;
+            }
+
+            return true;
+        }
+
+        private void OnBeforeCollect(IntPtr callbackState)
+        {
+            Interlocked.Increment(ref _collectionCount);
+        }
+
+        private async void OnSuspending(object sender, SuspendingEventArgs e)
+        {
+            var deferral = e.SuspendingOperation.GetDeferral();
+            try
+            {
+                await TrimAsync(SuspendReason);
+            }
+            finally
+            {
+                deferral.Complete();
+            }
+        }
+
+        private void OnAppMemoryUsageIncreased(object sender, object e)
+        {
+            if (MemoryManager.AppMemoryUsageLevel >= AppMemoryUsageLevel.High)
+            {
+                ScheduleTrim(LowMemoryReason, MessageQueuePriority.Immediate);
+            }
+        }
+
+        private void OnAppMemoryUsageLimitChanging(object sender, AppMemoryUsageLimitChangingEventArgs e)
+        {
+            // The limit drops when the application moves to the background.
+            if (e.NewLimit < e.OldLimit)
+            {
+                ScheduleTrim(LowMemoryReason, MessageQueuePriority.Immediate);
+            }
+        }
+
+        private void ScheduleTrim(string reason, MessageQueuePriority priority)
+        {
+            // Pressure is reported repeatedly, but one pending trim is enough.
+            if (Interlocked.Exchange(ref _trimPending, 1) == 0)
+            {
+                _jsQueueThread.RunOnQueue(() => Trim(reason), priority);
+            }
+        }
+
+        private Task TrimAsync(string reason)
+        {
+            var completionSource = new TaskCompletionSource<bool>(TaskCreationOptions.RunContinuationsAsynchronously);
+            _jsQueueThread.RunOnQueue(
+                () =>
+                {
+                    try
+                    {
+                        Trim(reason);
+                        completionSource.SetResult(true);
+                    }
+                    catch (Exception ex)
+                    {
+                        completionSource.SetException(ex);
+                    }
+                },
+                MessageQueuePriority.Immediate);
+
+            return completionSource.Task;
+        }
+
+        private void Trim(string reason)
+        {
+            Volatile.Write(ref _trimPending, 0);
+            if (!_runtime.IsValid)
+            {
+                return;
+            }
+
+            var heapSize = HeapSize;
+
+            foreach (var listener in _trimMemoryListeners)
+            {
+                var actionQueue = ((INativeModule)listener).ActionQueue;
+                if (actionQueue == null)
+                {
+                    listener.OnTrimMemory();
+                }
+                else
+                {
+                    actionQueue.RunOnQueue(listener.OnTrimMemory);
+                }
+            }
+
+            _runtime.CollectGarbage();
+            Interlocked.Increment(ref _trimCount);
+
+            //
+            // Whatever survived is live, so the next trim for the budget
+            // waits for the heap to grow by another eighth of it.
+            //
+            var budgetThreshold = (long)(Budget / 4 * 3);
+            Interlocked.Exchange(ref _trimThreshold, Math.Max(budgetThreshold, HeapSize + (long)(Budget / 8)));
+
+            if (ReactEventSource.Log.IsEnabled(EventLevel.Informational, ReactEventSource.Keywords.Memory))
+            {
+                ReactEventSource.Log.HeapTrimmed(reason, heapSize, HeapSize);
+            }
+        }
+
+        /// <summary>
+        /// Gets the heap budget for this device.
+        /// </summary>
+        /// <remarks>
+        /// The JavaScript heap gets a quarter of the memory the OS lets the
+        /// application use in the foreground.
+        /// </remarks>
+        /// <returns>The budget, in bytes.</returns>
+        public static ulong GetDefaultBudget()
+        {
+            return MemoryManager.AppMemoryUsageLimit / 4;
+        }
+    }
+}
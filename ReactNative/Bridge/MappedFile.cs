@@ -0,0 +1,198 @@
+﻿using System;
+using System.Globalization;
+using System.IO;
+using System.Runtime.InteropServices;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// A read-only view of a file mapped into memory, so its contents can be
+    /// handed to native code without copying them into the managed heap.
+    /// </summary>
+    sealed class MappedFile : IDisposable
+    {
+        private const uint GENERIC_READ = 0x80000000;
+        private const uint FILE_SHARE_READ = 0x00000001;
+        private const uint OPEN_EXISTING = 3;
+        private const uint PAGE_READONLY = 0x02;
+        private const uint FILE_MAP_READ = 0x0004;
+
+        private static readonly IntPtr s_invalidHandleValue = new IntPtr(-1);
+
+        private IntPtr _fileHandle;
+        private IntPtr _mappingHandle;
+        private IntPtr _view;
+
+        private MappedFile(IntPtr fileHandle, IntPtr mappingHandle, IntPtr view, long length)
+        {
+            _fileHandle = fileHandle;
+            _mappingHandle = mappingHandle;
+            _view = view;
+            Length = length;
+        }
+
+        ~MappedFile()
+        {
+            Dispose(false);
+        }
+
+        public IntPtr Pointer
+        {
+            get
+            {
+                if (_view == IntPtr.Zero)
+                {
+                    throw new ObjectDisposedException(nameof(MappedFile));
+                }
+
+                return _view;
+            }
+        }
+
+        public long Length { get; }
+
+        public static MappedFile Open(string path)
+        {
+            if (path == null)
+                throw new ArgumentNullException(nameof(path));
+
+            var fileHandle = CreateFile2(path, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, IntPtr.Zero);
+            if (fileHandle == s_invalidHandleValue)
+            {
+                throw CreateException("open", path);
+            }
+
+            var mappingHandle = IntPtr.Zero;
+            try
+            {
+                var length = default(long);
+                if (!GetFileSizeEx(fileHandle, out length))
+                {
+                    throw CreateException("query the size of", path);
+                }
+
+                if (length == 0)
+                {
+                    throw new IOException(
+                        string.Format(
+                            CultureInfo.InvariantCulture,
+                            "Cannot map empty file '{0}'.",
+                            path));
+                }
+
+                mappingHandle = CreateFileMappingFromApp(fileHandle, IntPtr.Zero, PAGE_READONLY, 0, null);
+                if (mappingHandle == IntPtr.Zero)
+                {
+                    throw CreateException("create a mapping for", path);
+                }
+
+                var view = MapViewOfFileFromApp(mappingHandle, FILE_MAP_READ, 0, UIntPtr.Zero);
+                if (view == IntPtr.Zero)
+                {
+                    throw CreateException("map", path);
+                }
+
+                return new MappedFile(fileHandle, mappingHandle, view, length);
+            }
+            catch
+            {
+                if (mappingHandle != IntPtr.Zero)
+                {
+                    CloseHandle(mappingHandle);
+                }
+
+                CloseHandle(fileHandle);
+                throw;
+            }
+        }
+
+        /// <summary>
+        /// Maps a null-terminated UTF-16 script, so the view can be passed to
+        /// Chakra as a string.
+        /// </summary>
+        /// <param name="path">The path.</param>
+        /// <returns>The mapped file.</returns>
+        /// <exception cref="IOException">
+        /// Thrown if the file cannot be mapped, or is not a whole number of
+        /// UTF-16 code units ending in a null character.
+        /// </exception>
+        public static MappedFile OpenScript(string path)
+        {
+            var file = Open(path);
+
+            // Chakra reads up to the terminator, which must be inside the view.
+            if (file.Length % 2 != 0 || Marshal.ReadInt16(new IntPtr(file._view.ToInt64() + file.Length - 2)) != 0)
+            {
+                file.Dispose();
+                throw new IOException(
+                    string.Format(
+                        CultureInfo.InvariantCulture,
+                        "File '{0}' is not a null-terminated UTF-16 script.",
+                        path));
+            }
+
+            return file;
+        }
+
+        public void Dispose()
+        {
+            Dispose(true);
+            GC.SuppressFinalize(this);
+        }
+
+        private void Dispose(bool disposing)
+        {
+            if (_view != IntPtr.Zero)
+            {
+                UnmapViewOfFile(_view);
+                _view = IntPtr.Zero;
+            }
+
+            if (_mappingHandle != IntPtr.Zero)
+            {
+                CloseHandle(_mappingHandle);
+                _mappingHandle = IntPtr.Zero;
+            }
+
+            if (_fileHandle != IntPtr.Zero)
+            {
+                CloseHandle(_fileHandle);
+                _fileHandle = IntPtr.Zero;
+            }
+        }
+
+        private static IOException CreateException(string operation, string path)
+        {
+            var hresult = Marshal.GetHRForLastWin32Error();
+            return new IOException(
+                string.Format(
+                    CultureInfo.InvariantCulture,
+                    "Failed to {0} file '{1}' (0x{2:X8}).",
+                    operation,
+                    path,
+                    hresult),
+                hresult);
+        }
+
+        [DllImport("kernel32.dll", CharSet = CharSet.Unicode, SetLastError = true)]
+        private static extern IntPtr CreateFile2(string fileName, uint desiredAccess, uint shareMode, uint creationDisposition, IntPtr createExParams);
+
+        [DllImport("kernel32.dll", SetLastError = true)]
+        [return: MarshalAs(UnmanagedType.Bool)]
+        private static extern bool GetFileSizeEx(IntPtr file, out long fileSize);
+
+        [DllImport("kernel32.dll", CharSet = CharSet.Unicode, SetLastError = true)]
+        private static extern IntPtr CreateFileMappingFromApp(IntPtr file, IntPtr securityAttributes, uint pageProtection, ulong maximumSize, string name);
+
+        [DllImport("kernel32.dll", SetLastError = true)]
+        private static extern IntPtr MapViewOfFileFromApp(IntPtr fileMappingObject, uint desiredAccess, ulong fileOffset, UIntPtr numberOfBytesToMap);
+
+        [DllImport("kernel32.dll", SetLastError = true)]
+        [return: MarshalAs(UnmanagedType.Bool)]
+        private static extern bool UnmapViewOfFile(IntPtr baseAddress);
+
+        [DllImport("kernel32.dll", SetLastError = true)]
+        [return: MarshalAs(UnmanagedType.Bool)]
+        private static extern bool CloseHandle(IntPtr handle);
+    }
+}
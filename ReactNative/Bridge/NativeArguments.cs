@@ -0,0 +1,199 @@
+﻿using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using System;
+using System.Globalization;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// Converts JavaScript arguments to native method parameters.
+    /// </summary>
+    /// <remarks>
+    /// Shared by the invokers compiled at runtime and the precompiled
+    /// invokers of <see cref="GeneratedNativeMethod"/>, so both bind
+    /// arguments the same way. The reader methods advance the reader to the
+    /// next argument before reading it. The bridge hands batches to native
+    /// modules as a reader over the flushed queue, so the reader methods
+    /// are the ones used for calls from JavaScript, and the token methods
+    /// are used for calls that were loaded first, such as calls to modules
+    /// with their own queue.
+    /// </remarks>
+    public static class NativeArguments
+    {
+        private static readonly JsonSerializer s_serializer = JsonSerializer.CreateDefault();
+
+        /// <summary>
+        /// Checks that the reader has no arguments left.
+        /// </summary>
+        /// <param name="reader">The reader.</param>
+        /// <exception cref="ArgumentException">
+        /// Thrown if more arguments follow.
+        /// </exception>
+        public static void ReadEndArray(JsonReader reader)
+        {
+            if (!reader.Read() || reader.TokenType != JsonToken.EndArray)
+            {
+                throw new ArgumentException("Invalid argument count.");
+            }
+        }
+
+        /// <summary>
+        /// Reads the next argument as a 32-bit integer.
+        /// </summary>
+        /// <param name="reader">The reader.</param>
+        /// <returns>The argument.</returns>
+        public static int ReadInt32(JsonReader reader)
+        {
+            ReadNext(reader);
+            return Convert.ToInt32(ReadPrimitive(reader), CultureInfo.InvariantCulture);
+        }
+
+        /// <summary>
+        /// Reads the next argument as a double.
+        /// </summary>
+        /// <param name="reader">The reader.</param>
+        /// <returns>The argument.</returns>
+        public static double ReadDouble(JsonReader reader)
+        {
+            ReadNext(reader);
+            return Convert.ToDouble(ReadPrimitive(reader), CultureInfo.InvariantCulture);
+        }
+
+        /// <summary>
+        /// Reads the next argument as a boolean.
+        /// </summary>
+        /// <param name="reader">The reader.</param>
+        /// <returns>The argument.</returns>
+        public static bool ReadBoolean(JsonReader reader)
+        {
+            ReadNext(reader);
+            return Convert.ToBoolean(ReadPrimitive(reader), CultureInfo.InvariantCulture);
+        }
+
+        /// <summary>
+        /// Reads the next argument as a string.
+        /// </summary>
+        /// <param name="reader">The reader.</param>
+        /// <returns>The argument, or <b>null</b>.</returns>
+        public static string ReadString(JsonReader reader)
+        {
+            ReadNext(reader);
+            if (reader.TokenType == JsonToken.Null)
+            {
+                return null;
+            }
+
+            return Convert.ToString(ReadPrimitive(reader), CultureInfo.InvariantCulture);
+        }
+
+        /// <summary>
+        /// Deserializes the next argument.
+        /// </summary>
+        /// <typeparam name="T">The parameter type.</typeparam>
+        /// <param name="reader">The reader.</param>
+        /// <returns>The argument.</returns>
+        public static T Read<T>(JsonReader reader)
+        {
+            ReadNext(reader);
+            return s_serializer.Deserialize<T>(reader);
+        }
+
+        /// <summary>
+        /// Reads the next argument as a callback ID.
+        /// </summary>
+        /// <param name="reader">The reader.</param>
+        /// <param name="instance">The instance to invoke the callback on.</param>
+        /// <returns>The callback.</returns>
+        public static ICallback ReadCallback(JsonReader reader, ICatalystInstance instance)
+        {
+            return new Callback(ReadInt32(reader), instance);
+        }
+
+        /// <summary>
+        /// Checks the number of arguments.
+        /// </summary>
+        /// <param name="arguments">The arguments.</param>
+        /// <param name="count">The expected number of arguments.</param>
+        /// <exception cref="ArgumentException">
+        /// Thrown if the count does not match.
+        /// </exception>
+        public static void CheckArgumentCount(JArray arguments, int count)
+        {
+            if (arguments.Count != count)
+            {
+                throw new ArgumentException("Invalid argument count.");
+            }
+        }
+
+        /// <summary>
+        /// Converts an argument.
+        /// </summary>
+        /// <typeparam name="T">The parameter type.</typeparam>
+        /// <param name="value">The argument.</param>
+        /// <returns>The converted argument.</returns>
+        public static T Extract<T>(JToken value)
+        {
+            return value.ToObject<T>();
+        }
+
+        /// <summary>
+        /// Converts a callback ID argument.
+        /// </summary>
+        /// <param name="value">The argument.</param>
+        /// <param name="instance">The instance to invoke the callback on.</param>
+        /// <returns>The callback.</returns>
+        public static ICallback ExtractCallback(JToken value, ICatalystInstance instance)
+        {
+            var id = value.Value<int>();
+            return new Callback(id, instance);
+        }
+
+        private static void ReadNext(JsonReader reader)
+        {
+            if (!reader.Read() || reader.TokenType == JsonToken.EndArray)
+            {
+                throw new ArgumentException("Invalid argument count.");
+            }
+        }
+
+        private static object ReadPrimitive(JsonReader reader)
+        {
+            switch (reader.TokenType)
+            {
+                case JsonToken.Integer:
+                case JsonToken.Float:
+                case JsonToken.Boolean:
+                case JsonToken.String:
+                    return reader.Value;
+                default:
+                    throw new ArgumentException(
+                        string.Format(
+                            CultureInfo.InvariantCulture,
+                            "Unexpected token '{0}' for primitive argument.",
+                            reader.TokenType));
+            }
+        }
+
+        class Callback : ICallback
+        {
+            private readonly int _id;
+            private readonly ICatalystInstance _instance;
+
+            public Callback(int id, ICatalystInstance instance)
+            {
+                _id = id;
+                _instance = instance;
+            }
+
+            public void Invoke(params object[] arguments)
+            {
+                // Batched and queued callbacks are marshaled after this returns.
+                arguments = NativeBuffer.Reference(arguments);
+                if (!CallbackBatch.TryAdd(_instance, _id, arguments))
+                {
+                    _instance.InvokeCallback(_id, arguments);
+                }
+            }
+        }
+    }
+}
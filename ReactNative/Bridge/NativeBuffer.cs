@@ -0,0 +1,285 @@
+﻿using ReactNative.Hosting;
+using System;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// A block of memory that is passed to JavaScript by reference, as an
+    /// <c>ArrayBuffer</c>, instead of being copied or encoded.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Pass the buffer as a callback or function argument. Each
+    /// <c>ArrayBuffer</c> created over it keeps the memory alive until the
+    /// JavaScript garbage collector finalizes it. Callbacks may be sent
+    /// after they are invoked, e.g., at the end of a batch, so a callback
+    /// also keeps the buffers among its arguments alive until they are
+    /// marshaled. The native owner can dispose of the buffer as soon as
+    /// the callback has been invoked.
+    /// </para>
+    /// <para>
+    /// Do not write to the memory once it has been sent.
+    /// </para>
+    /// </remarks>
+    public sealed class NativeBuffer : IDisposable
+    {
+        // Kept alive for as long as the runtime may call it.
+        private static readonly JavaScriptObjectFinalizeCallback s_finalizeCallback = OnFinalize;
+
+        private readonly IntPtr _data;
+        private readonly int _length;
+        private readonly GCHandle _pin;
+
+        private int _referenceCount = 1;
+        private int _disposed;
+
+        private NativeBuffer(IntPtr data, int length, GCHandle pin)
+        {
+            _data = data;
+            _length = length;
+            _pin = pin;
+        }
+
+        /// <summary>
+        /// A pointer to the memory.
+        /// </summary>
+        public IntPtr Data
+        {
+            get
+            {
+                if (Volatile.Read(ref _disposed) != 0)
+                {
+                    throw new ObjectDisposedException(nameof(NativeBuffer));
+                }
+
+                return _data;
+            }
+        }
+
+        /// <summary>
+        /// The number of bytes in the buffer.
+        /// </summary>
+        public int Length
+        {
+            get
+            {
+                return _length;
+            }
+        }
+
+        /// <summary>
+        /// Allocates a buffer of unmanaged memory, e.g., to read a file or
+        /// decode media into.
+        /// </summary>
+        /// <param name="length">The number of bytes.</param>
+        /// <returns>The buffer.</returns>
+        public static NativeBuffer Allocate(int length)
+        {
+            if (length < 0)
+                throw new ArgumentOutOfRangeException(nameof(length));
+
+            return new NativeBuffer(Marshal.AllocHGlobal(length), length, default(GCHandle));
+        }
+
+        /// <summary>
+        /// Creates a buffer over a byte array, which stays pinned until the
+        /// buffer is released.
+        /// </summary>
+        /// <remarks>
+        /// Long-lived pins fragment the managed heap, so prefer
+        /// <see cref="Allocate(int)"/> for large or long-lived data.
+        /// </remarks>
+        /// <param name="bytes">The bytes.</param>
+        /// <returns>The buffer.</returns>
+        public static NativeBuffer Pin(byte[] bytes)
+        {
+            if (bytes == null)
+                throw new ArgumentNullException(nameof(bytes));
+
+            var pin = GCHandle.Alloc(bytes, GCHandleType.Pinned);
+            return new NativeBuffer(pin.AddrOfPinnedObject(), bytes.Length, pin);
+        }
+
+        /// <summary>
+        /// Releases the native owner's reference to the buffer. The memory is
+        /// freed once no <c>ArrayBuffer</c> refers to it either.
+        /// </summary>
+        public void Dispose()
+        {
+            if (Interlocked.Exchange(ref _disposed, 1) == 0)
+            {
+                Release();
+            }
+        }
+
+        /// <summary>
+        /// Takes a reference to each buffer among the arguments of a call
+        /// that may be marshaled later.
+        /// </summary>
+        /// <param name="arguments">The arguments.</param>
+        /// <returns>
+        /// The arguments, or a copy with each buffer replaced by a
+        /// <see cref="QueuedReference"/>.
+        /// </returns>
+        internal static object[] Reference(object[] arguments)
+        {
+            var referenced = default(object[]);
+            for (var i = 0; arguments != null && i < arguments.Length; ++i)
+            {
+                var buffer = arguments[i] as NativeBuffer;
+                if (buffer != null)
+                {
+                    // The caller's array is left as it is.
+                    if (referenced == null)
+                    {
+                        referenced = (object[])arguments.Clone();
+                    }
+
+                    referenced[i] = new QueuedReference(buffer);
+                }
+            }
+
+            return referenced ?? arguments;
+        }
+
+        /// <summary>
+        /// Creates an <c>ArrayBuffer</c> over the memory.
+        /// </summary>
+        /// <remarks>
+        /// Requires an active script context.
+        /// </remarks>
+        /// <returns>The <c>ArrayBuffer</c>.</returns>
+        internal JavaScriptValue ToArrayBuffer()
+        {
+            AddRef();
+            var handle = GCHandle.Alloc(this);
+            try
+            {
+                return JavaScriptValue.CreateExternalArrayBuffer(_data, (uint)_length, s_finalizeCallback, GCHandle.ToIntPtr(handle));
+            }
+            catch
+            {
+                handle.Free();
+                Release();
+                throw;
+            }
+        }
+
+        /// <summary>
+        /// Copies the memory, for runtimes without external <c>ArrayBuffer</c>s.
+        /// </summary>
+        /// <returns>The bytes.</returns>
+        internal byte[] ToArray()
+        {
+            AddRef();
+            try
+            {
+                var bytes = new byte[_length];
+                Marshal.Copy(_data, bytes, 0, _length);
+                return bytes;
+            }
+            finally
+            {
+                Release();
+            }
+        }
+
+        private void AddRef()
+        {
+            //
+            // References keep the memory alive, rather than the owner, so a
+            // buffer the owner has disposed can still be marshaled for a
+            // queued callback. Once the count has dropped to zero the
+            // memory is gone, and must not be revived.
+            //
+            var count = Volatile.Read(ref _referenceCount);
+            while (count > 0)
+            {
+                var previous = Interlocked.CompareExchange(ref _referenceCount, count + 1, count);
+                if (previous == count)
+                {
+                    return;
+                }
+
+                count = previous;
+            }
+
+            throw new ObjectDisposedException(nameof(NativeBuffer));
+        }
+
+        private void Release()
+        {
+            if (Interlocked.Decrement(ref _referenceCount) != 0)
+            {
+                return;
+            }
+
+            if (_pin.IsAllocated)
+            {
+                _pin.Free();
+            }
+            else
+            {
+                Marshal.FreeHGlobal(_data);
+            }
+        }
+
+        private static void OnFinalize(IntPtr callbackState)
+        {
+            var handle = GCHandle.FromIntPtr(callbackState);
+            var buffer = (NativeBuffer)handle.Target;
+            handle.Free();
+            buffer.Release();
+        }
+
+        /// <summary>
+        /// A reference to a buffer held by a call until its arguments are
+        /// marshaled.
+        /// </summary>
+        /// <remarks>
+        /// A call that is dropped without being marshaled releases its
+        /// references when they are finalized.
+        /// </remarks>
+        internal sealed class QueuedReference
+        {
+            private NativeBuffer _buffer;
+
+            public QueuedReference(NativeBuffer buffer)
+            {
+                buffer.AddRef();
+                _buffer = buffer;
+            }
+
+            ~QueuedReference()
+            {
+                Release();
+            }
+
+            public NativeBuffer Buffer
+            {
+                get
+                {
+                    var buffer = Volatile.Read(ref _buffer);
+                    if (buffer == null)
+                    {
+                        throw new ObjectDisposedException(nameof(QueuedReference));
+                    }
+
+                    return buffer;
+                }
+            }
+
+            public void Release()
+            {
+                var buffer = Interlocked.Exchange(ref _buffer, null);
+                if (buffer != null)
+                {
+                    buffer.Release();
+                    GC.SuppressFinalize(this);
+                }
+            }
+        }
+    }
+}
@@ -1,16 +1,40 @@
-﻿using Newtonsoft.Json.Linq;
+﻿using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using ReactNative.Bridge.Queue;
 using ReactNative.Reflection;
+using ReactNative.Tracing;
 using System;
 using System.Collections.Generic;
+using System.Diagnostics.Tracing;
 using System.Linq.Expressions;
 using System.Reflection;
+using System.Threading.Tasks;
 
 namespace ReactNative.Bridge
 {
     public abstract class NativeModuleBase : INativeModule
     {
-        private IReadOnlyDictionary<string, INativeMethod> _methods;
-        private IReadOnlyDictionary<string, object> _constants;
+        private readonly Lazy<IReadOnlyDictionary<string, INativeMethod>> _methods;
+        private readonly Lazy<IReadOnlyDictionary<string, object>> _constants;
+
+        protected NativeModuleBase()
+        {
+            //
+            // Reflection over the module and the creation of its constants
+            // are deferred until the module is first used from JavaScript,
+            // so registering modules that are never called costs nothing.
+            //
+            _methods = new Lazy<IReadOnlyDictionary<string, INativeMethod>>(InitializeMethods);
+            _constants = new Lazy<IReadOnlyDictionary<string, object>>(CreateConstants);
+        }
+
+        public virtual IMessageQueueThread ActionQueue
+        {
+            get
+            {
+                return null;
+            }
+        }
 
         public virtual bool CanOverrideExistingModule
         {
@@ -24,20 +48,23 @@ namespace ReactNative.Bridge
         {
             get
             {
-                return _constants;
+                return _constants.Value;
             }
         }
 
-        public IReadOnlyDictionary<string, INativeMethod> Methods
+        public virtual bool HasStableConstants
         {
             get
             {
-                if (_methods == null)
-                {
-                    throw new InvalidOperationException("Module has not been initialized.");
-                }
+                return false;
+            }
+        }
 
-                return _methods;
+        public IReadOnlyDictionary<string, INativeMethod> Methods
+        {
+            get
+            {
+                return _methods.Value;
             }
         }
 
@@ -46,10 +73,8 @@ namespace ReactNative.Bridge
             get;
         }
 
-        public void Initialize()
+        public virtual void Initialize()
         {
-            _methods = InitializeMethods();
-            _constants = CreateConstants();
         }
 
         public virtual void OnCatalystInstanceDestroy()
@@ -61,8 +86,34 @@ namespace ReactNative.Bridge
             return new Dictionary<string, object>();
         }
 
+        /// <summary>
+        /// Gets a method table with precompiled invokers for the module.
+        /// </summary>
+        /// <remarks>
+        /// A module can override this to map each of its
+        /// <see cref="ReactMethodAttribute"/> methods to a
+        /// <see cref="GeneratedNativeMethod"/> whose invokers are written
+        /// ahead of time. Projects that import
+        /// <c>ReactNative.Build.targets</c> have the override generated for
+        /// each module declared <c>partial</c>. The table must cover every
+        /// exported method. The default returns <b>null</b>, and the
+        /// methods are discovered with reflection and compiled on first
+        /// call instead.
+        /// </remarks>
+        /// <returns>The method table, or <b>null</b>.</returns>
+        protected virtual IReadOnlyDictionary<string, INativeMethod> CreateGeneratedMethods()
+        {
+            return null;
+        }
+
         private IReadOnlyDictionary<string, INativeMethod> InitializeMethods()
         {
+            var generatedMethods = CreateGeneratedMethods();
+            if (generatedMethods != null)
+            {
+                return generatedMethods;
+            }
+
             var declaredMethods = GetType().GetTypeInfo().DeclaredMethods;
             var exportedMethods = new List<MethodInfo>();
             foreach (var method in declaredMethods)
@@ -90,18 +141,15 @@ namespace ReactNative.Bridge
             private readonly NativeModuleBase _instance;
 
             private readonly Lazy<Action<ICatalystInstance, JArray>> _invokeDelegate;
+            private readonly Lazy<Action<ICatalystInstance, JsonReader>> _readerInvokeDelegate;
 
             public NativeMethod(NativeModuleBase instance, MethodInfo method)
             {
                 _instance = instance;
                 _invokeDelegate = new Lazy<Action<ICatalystInstance, JArray>>(() => GenerateExpression(instance, method).Compile());
+                _readerInvokeDelegate = new Lazy<Action<ICatalystInstance, JsonReader>>(() => GenerateReaderExpression(instance, method).Compile());
 
-                if (method.IsAsync())
-                {
-                    throw new NotImplementedException("Async methods not yet supported.");
-                }
-
-                Type = METHOD_TYPE_REMOTE;
+                Type = method.IsAsync() ? METHOD_TYPE_REMOTE_ASYNC : METHOD_TYPE_REMOTE;
             }
 
             public string Type
@@ -111,14 +159,34 @@ namespace ReactNative.Bridge
 
             public void Invoke(ICatalystInstance instance, JArray parameters)
             {
-                
+                _invokeDelegate.Value(instance, parameters);
+            }
+
+            public void Invoke(ICatalystInstance instance, JsonReader reader)
+            {
+                _readerInvokeDelegate.Value(instance, reader);
             }
 
-            private static MethodInfo s_extractCallback = (MethodInfo)ReflectionHelpers.InfoOf(() => ExtractCallback(default(JToken), default(ICatalystInstance)));
-            private static MethodInfo s_extractGeneric = ((MethodInfo)ReflectionHelpers.InfoOf(() => Extract<object>(default(JToken)))).GetGenericMethodDefinition();
+            private static MethodInfo s_extractCallback = (MethodInfo)ReflectionHelpers.InfoOf(() => NativeArguments.ExtractCallback(default(JToken), default(ICatalystInstance)));
+            private static MethodInfo s_extractGeneric = ((MethodInfo)ReflectionHelpers.InfoOf(() => NativeArguments.Extract<object>(default(JToken)))).GetGenericMethodDefinition();
+            private static MethodInfo s_getItemMethod = (MethodInfo)ReflectionHelpers.InfoOf((JArray arr) => arr[0]);
             private static PropertyInfo s_countProperty = (PropertyInfo)ReflectionHelpers.InfoOf((JArray arr) => arr.Count);
             private static Expression s_throwExpression = Expression.Throw(Expression.Constant(new ArgumentException("Invalid argument count.")));
 
+            private static MethodInfo s_readCallback = (MethodInfo)ReflectionHelpers.InfoOf(() => NativeArguments.ReadCallback(default(JsonReader), default(ICatalystInstance)));
+            private static MethodInfo s_readInt32 = (MethodInfo)ReflectionHelpers.InfoOf(() => NativeArguments.ReadInt32(default(JsonReader)));
+            private static MethodInfo s_readDouble = (MethodInfo)ReflectionHelpers.InfoOf(() => NativeArguments.ReadDouble(default(JsonReader)));
+            private static MethodInfo s_readBoolean = (MethodInfo)ReflectionHelpers.InfoOf(() => NativeArguments.ReadBoolean(default(JsonReader)));
+            private static MethodInfo s_readString = (MethodInfo)ReflectionHelpers.InfoOf(() => NativeArguments.ReadString(default(JsonReader)));
+            private static MethodInfo s_readGeneric = ((MethodInfo)ReflectionHelpers.InfoOf(() => NativeArguments.Read<object>(default(JsonReader)))).GetGenericMethodDefinition();
+            private static MethodInfo s_readEndArray = (MethodInfo)ReflectionHelpers.InfoOf(() => NativeArguments.ReadEndArray(default(JsonReader)));
+
+            private static MethodInfo s_isTracing = (MethodInfo)ReflectionHelpers.InfoOf(() => ReactEventSource.Log.IsEnabled(default(EventKeywords)));
+            private static MethodInfo s_argumentsDecoded = (MethodInfo)ReflectionHelpers.InfoOf(() => ReactEventSource.Log.NativeCallArgumentsDecoded(default(string)));
+
+            private static MethodInfo s_bindPromise = (MethodInfo)ReflectionHelpers.InfoOf(() => NativePromise.Bind(default(Task), default(ICallback), default(ICallback)));
+            private static MethodInfo s_bindPromiseGeneric = ((MethodInfo)ReflectionHelpers.InfoOf(() => NativePromise.Bind<object>(default(Task<object>), default(ICallback), default(ICallback)))).GetGenericMethodDefinition();
+
             private static Expression<Action<ICatalystInstance, JArray>> GenerateExpression(NativeModuleBase instance, MethodInfo method)
             {
                 var parameterInfos = method.GetParameters();
@@ -146,8 +214,9 @@ namespace ReactNative.Bridge
                             parameterExpression,
                             Expression.Call(
                                 s_extractCallback,
-                                Expression.ArrayIndex(
+                                Expression.Call(
                                     jsArgumentsParameter,
+                                    s_getItemMethod,
                                     Expression.Constant(i)
                                 ),
                                 catalystInstanceParameter
@@ -165,8 +234,9 @@ namespace ReactNative.Bridge
                             parameterExpression,
                             Expression.Call(
                                 extractMethod,
-                                Expression.ArrayIndex(
+                                Expression.Call(
                                     jsArgumentsParameter,
+                                    s_getItemMethod,
                                     Expression.Constant(i)
                                 )
                             )
@@ -174,16 +244,23 @@ namespace ReactNative.Bridge
                     }
                 }
 
-                var blockStatements = new Expression[parameterInfos.Length + 2];
+                var blockStatements = new Expression[parameterInfos.Length + 3];
+
+                //
+                // Promise-returning methods take the resolve and reject
+                // callbacks after the declared parameters.
+                //
+                var isAsync = method.IsAsync();
+                var argumentCount = isAsync ? n + 2 : n;
 
                 //
-                // if (args.Count != valueOf(n))
+                // if (args.Count != valueOf(argumentCount))
                 //     throw new ArgumentException("Invalid argument count.");
                 //
                 blockStatements[0] = Expression.Condition(
                     Expression.NotEqual(
                         Expression.Property(jsArgumentsParameter, s_countProperty),
-                        Expression.Constant(n)
+                        Expression.Constant(argumentCount)
                     ),
                     s_throwExpression,
                     Expression.Empty()
@@ -196,12 +273,26 @@ namespace ReactNative.Bridge
                 // pn = Extract<T>(jsArguments[n]);
                 //
                 Array.Copy(extractExpressions, 0, blockStatements, 1, parameterInfos.Length);
+                blockStatements[parameterInfos.Length + 1] = GenerateTraceExpression(instance, method);
 
-                blockStatements[parameterInfos.Length + 1] = Expression.Call(
+                var callExpression = Expression.Call(
                     Expression.Constant(instance),
                     method,
                     parameterExpressions);
 
+                blockStatements[parameterInfos.Length + 2] = isAsync
+                    ? GenerateBindPromiseExpression(
+                        callExpression,
+                        Expression.Call(
+                            s_extractCallback,
+                            Expression.Call(jsArgumentsParameter, s_getItemMethod, Expression.Constant(n)),
+                            catalystInstanceParameter),
+                        Expression.Call(
+                            s_extractCallback,
+                            Expression.Call(jsArgumentsParameter, s_getItemMethod, Expression.Constant(n + 1)),
+                            catalystInstanceParameter))
+                    : callExpression;
+
                 return Expression.Lambda<Action<ICatalystInstance, JArray>>(
                     Expression.Block(parameterExpressions, blockStatements),
                     catalystInstanceParameter,
@@ -209,32 +300,123 @@ namespace ReactNative.Bridge
                 );
             }
 
-            private static T Extract<T>(JToken value)
+            private static Expression<Action<ICatalystInstance, JsonReader>> GenerateReaderExpression(NativeModuleBase instance, MethodInfo method)
             {
-                return value.ToObject<T>();
+                var parameterInfos = method.GetParameters();
+                var n = parameterInfos.Length;
+
+                var parameterExpressions = new ParameterExpression[n];
+                var blockStatements = new Expression[n + 3];
+
+                var catalystInstanceParameter = Expression.Parameter(typeof(ICatalystInstance), "catalystInstance");
+                var readerParameter = Expression.Parameter(typeof(JsonReader), "reader");
+
+                //
+                // p0 = ReadT(reader);
+                // p1 = ReadT(reader);
+                // ...
+                // pn = ReadT(reader);
+                //
+                for (var i = 0; i < n; ++i)
+                {
+                    var parameterInfo = parameterInfos[i];
+                    var parameterExpression = Expression.Parameter(parameterInfo.ParameterType, parameterInfo.Name);
+                    parameterExpressions[i] = parameterExpression;
+                    blockStatements[i] = Expression.Assign(
+                        parameterExpression,
+                        GenerateReadExpression(parameterInfo.ParameterType, readerParameter, catalystInstanceParameter));
+                }
+
+                var variables = parameterExpressions;
+                var callExpression = (Expression)Expression.Call(
+                    Expression.Constant(instance),
+                    method,
+                    parameterExpressions);
+
+                if (method.IsAsync())
+                {
+                    //
+                    // resolve = ReadCallback(reader, catalystInstance);
+                    // reject = ReadCallback(reader, catalystInstance);
+                    //
+                    var resolveExpression = Expression.Parameter(typeof(ICallback), "resolve");
+                    var rejectExpression = Expression.Parameter(typeof(ICallback), "reject");
+                    variables = new ParameterExpression[n + 2];
+                    Array.Copy(parameterExpressions, variables, n);
+                    variables[n] = resolveExpression;
+                    variables[n + 1] = rejectExpression;
+
+                    Array.Resize(ref blockStatements, n + 5);
+                    blockStatements[n] = Expression.Assign(resolveExpression, Expression.Call(s_readCallback, readerParameter, catalystInstanceParameter));
+                    blockStatements[n + 1] = Expression.Assign(rejectExpression, Expression.Call(s_readCallback, readerParameter, catalystInstanceParameter));
+                    callExpression = GenerateBindPromiseExpression(callExpression, resolveExpression, rejectExpression);
+                }
+
+                //
+                // ReadEndArray(reader);
+                //
+                blockStatements[blockStatements.Length - 3] = Expression.Call(s_readEndArray, readerParameter);
+                blockStatements[blockStatements.Length - 2] = GenerateTraceExpression(instance, method);
+                blockStatements[blockStatements.Length - 1] = callExpression;
+
+                return Expression.Lambda<Action<ICatalystInstance, JsonReader>>(
+                    Expression.Block(variables, blockStatements),
+                    catalystInstanceParameter,
+                    readerParameter
+                );
             }
 
-            private static ICallback ExtractCallback(JToken value, ICatalystInstance instance)
+            private static Expression GenerateTraceExpression(NativeModuleBase instance, MethodInfo method)
             {
-                var id = value.Value<int>();
-                return new Callback(id, instance);
+                var log = Expression.Constant(ReactEventSource.Log);
+                var tracingName = "NativeCall__" + instance.Name + "_" + method.Name;
+
+                //
+                // if (ReactEventSource.Log.IsEnabled(ReactEventSource.Keywords.NativeCall))
+                //     ReactEventSource.Log.NativeCallArgumentsDecoded(valueOf(tracingName));
+                //
+                return Expression.IfThen(
+                    Expression.Call(log, s_isTracing, Expression.Constant(ReactEventSource.Keywords.NativeCall)),
+                    Expression.Call(log, s_argumentsDecoded, Expression.Constant(tracingName)));
             }
-            
-            class Callback : ICallback
+
+            private static Expression GenerateBindPromiseExpression(Expression task, Expression resolve, Expression reject)
             {
-                private readonly int _id;
-                private readonly ICatalystInstance _instance;
+                var taskType = task.Type;
+                var bindMethod = taskType.IsConstructedGenericType && taskType.GetGenericTypeDefinition() == typeof(Task<>)
+                    ? s_bindPromiseGeneric.MakeGenericMethod(taskType.GenericTypeArguments[0])
+                    : s_bindPromise;
 
-                public Callback(int id, ICatalystInstance instance)
+                //
+                // NativePromise.Bind(instance.method(p0, ..., pn), resolve, reject);
+                //
+                return Expression.Call(bindMethod, task, resolve, reject);
+            }
+
+            private static Expression GenerateReadExpression(Type parameterType, Expression reader, Expression catalystInstance)
+            {
+                if (parameterType == typeof(ICallback))
                 {
-                    _id = id;
-                    _instance = instance;
+                    return Expression.Call(s_readCallback, reader, catalystInstance);
                 }
-
-                public void Invoke(params object[] arguments)
+                else if (parameterType == typeof(int))
+                {
+                    return Expression.Call(s_readInt32, reader);
+                }
+                else if (parameterType == typeof(double))
                 {
-                    _instance.InvokeCallback(_id, JArray.FromObject(arguments));
+                    return Expression.Call(s_readDouble, reader);
                 }
+                else if (parameterType == typeof(bool))
+                {
+                    return Expression.Call(s_readBoolean, reader);
+                }
+                else if (parameterType == typeof(string))
+                {
+                    return Expression.Call(s_readString, reader);
+                }
+
+                return Expression.Call(s_readGeneric.MakeGenericMethod(parameterType), reader);
             }
         }
     }
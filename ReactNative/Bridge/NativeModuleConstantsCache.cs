@@ -0,0 +1,202 @@
+﻿using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using ReactNative.Tracing;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics.Tracing;
+using System.Globalization;
+using System.IO;
+using System.Threading.Tasks;
+using Windows.ApplicationModel;
+using Windows.Storage;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// Keeps the constants of modules with
+    /// <see cref="INativeModule.HasStableConstants"/> across launches, so
+    /// they are only created once per version of the application.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Pass the cache to
+    /// <see cref="NativeModuleRegistry.Builder.SetConstantsCache"/>. Modules
+    /// whose constants are in the cache are configured from it without
+    /// calling <c>CreateConstants</c>, and constants created for the other
+    /// stable modules are added to it.
+    /// </para>
+    /// <para>
+    /// The cache is stored in local app storage, next to the bytecode
+    /// cache, and is discarded when the version changes.
+    /// </para>
+    /// </remarks>
+    public sealed class NativeModuleConstantsCache
+    {
+        private const string CacheFolderName = "ReactNative";
+        private const string CacheFileName = "constants.json";
+        private const string VersionPropertyName = "version";
+        private const string ModulesPropertyName = "modules";
+
+        // Thrown by FileIO.ReadTextAsync for a file that is not valid UTF-8.
+        private const int ERROR_NO_UNICODE_TRANSLATION = unchecked((int)0x80070459);
+
+        private readonly object _gate = new object();
+        private readonly JObject _modules;
+
+        private bool _isDirty;
+
+        /// <summary>
+        /// Instantiates an empty <see cref="NativeModuleConstantsCache"/>.
+        /// </summary>
+        /// <param name="version">The version the constants belong to.</param>
+        public NativeModuleConstantsCache(string version)
+            : this(version, new JObject())
+        {
+        }
+
+        private NativeModuleConstantsCache(string version, JObject modules)
+        {
+            if (version == null)
+                throw new ArgumentNullException(nameof(version));
+
+            Version = version;
+            _modules = modules;
+        }
+
+        public string Version { get; }
+
+        /// <summary>
+        /// Loads the cache for the version of the application package.
+        /// </summary>
+        /// <returns>The cache.</returns>
+        public static Task<NativeModuleConstantsCache> LoadAsync()
+        {
+            var version = Package.Current.Id.Version;
+            return LoadAsync(
+                string.Format(
+                    CultureInfo.InvariantCulture,
+                    "{0}.{1}.{2}.{3}",
+                    version.Major,
+                    version.Minor,
+                    version.Build,
+                    version.Revision));
+        }
+
+        /// <summary>
+        /// Loads the cache for a version.
+        /// </summary>
+        /// <param name="version">The version.</param>
+        /// <returns>
+        /// The cache, which is empty if the stored cache is missing, from
+        /// another version or unreadable.
+        /// </returns>
+        public static async Task<NativeModuleConstantsCache> LoadAsync(string version)
+        {
+            if (version == null)
+                throw new ArgumentNullException(nameof(version));
+
+            try
+            {
+                var cacheFolder = await GetCacheFolderAsync();
+                var cacheFile = await cacheFolder.TryGetItemAsync(CacheFileName) as StorageFile;
+                if (cacheFile != null)
+                {
+                    var cache = JObject.Parse(await FileIO.ReadTextAsync(cacheFile));
+                    var modules = cache[ModulesPropertyName] as JObject;
+                    if (modules != null && cache.Value<string>(VersionPropertyName) == version)
+                    {
+                        return new NativeModuleConstantsCache(version, modules);
+                    }
+                }
+            }
+            catch (Exception ex)
+            when (ex is JsonException || ex is InvalidCastException || ex is UnauthorizedAccessException ||
+                  ex is IOException || ex.HResult == ERROR_NO_UNICODE_TRANSLATION)
+            {
+                if (ReactEventSource.Log.IsEnabled(EventLevel.Warning, ReactEventSource.Keywords.Cache))
+                {
+                    ReactEventSource.Log.CacheFailed(CacheFileName, ex.ToString());
+                }
+            }
+
+            return new NativeModuleConstantsCache(version);
+        }
+
+        /// <summary>
+        /// Gets the cached constants of a module.
+        /// </summary>
+        /// <param name="moduleName">The module name.</param>
+        /// <param name="constants">Receives the constants.</param>
+        /// <returns><b>true</b> if the constants are cached.</returns>
+        public bool TryGetConstants(string moduleName, out JObject constants)
+        {
+            if (moduleName == null)
+                throw new ArgumentNullException(nameof(moduleName));
+
+            lock (_gate)
+            {
+                constants = _modules[moduleName] as JObject;
+                return constants != null;
+            }
+        }
+
+        /// <summary>
+        /// Adds the constants of a module to the cache.
+        /// </summary>
+        /// <param name="moduleName">The module name.</param>
+        /// <param name="constants">The constants.</param>
+        public void SetConstants(string moduleName, JObject constants)
+        {
+            if (moduleName == null)
+                throw new ArgumentNullException(nameof(moduleName));
+            if (constants == null)
+                throw new ArgumentNullException(nameof(constants));
+
+            lock (_gate)
+            {
+                _modules[moduleName] = constants;
+                _isDirty = true;
+            }
+        }
+
+        /// <summary>
+        /// Stores the cache, if constants were added since it was loaded.
+        /// </summary>
+        /// <remarks>
+        /// Module configurations are created as JavaScript first reads them,
+        /// so call this once the bundle has started, e.g., off the critical
+        /// path after the first batch.
+        /// </remarks>
+        /// <returns>A task to await the save.</returns>
+        public async Task SaveAsync()
+        {
+            var text = default(string);
+            lock (_gate)
+            {
+                if (!_isDirty)
+                {
+                    return;
+                }
+
+                text = new JObject
+                {
+                    { VersionPropertyName, Version },
+                    { ModulesPropertyName, _modules.DeepClone() },
+                }.ToString(Formatting.None);
+
+                _isDirty = false;
+            }
+
+            // Replaced in one step, so an interrupted save keeps the old cache.
+            var cacheFolder = await GetCacheFolderAsync();
+            await cacheFolder.ReplaceFileAsync(CacheFileName, file => FileIO.WriteTextAsync(file, text).AsTask());
+        }
+
+        private static async Task<StorageFolder> GetCacheFolderAsync()
+        {
+            return await ApplicationData.Current.LocalCacheFolder.CreateFolderAsync(
+                CacheFolderName,
+                CreationCollisionOption.OpenIfExists);
+        }
+    }
+}
@@ -1,8 +1,12 @@
-﻿using Newtonsoft.Json.Linq;
+﻿using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using ReactNative.Bridge.Queue;
+using ReactNative.Tracing;
 using System;
 using System.Collections.Generic;
 using System.Globalization;
 using System.Linq;
+using System.Threading;
 
 namespace ReactNative.Bridge
 {
@@ -12,6 +16,14 @@ namespace ReactNative.Bridge
         private readonly IDictionary<Type, INativeModule> _moduleInstances;
         private readonly IList<IOnBatchCompleteListener> _batchCompleteListenerModules;
 
+        //
+        // The ID buffers are reused from batch to batch. A native method can
+        // re-enter the registry with a nested batch, so each batch takes the
+        // buffers for itself, and one that finds them taken gets new ones.
+        //
+        private List<int> _moduleIdBuffer = new List<int>();
+        private List<int> _methodIdBuffer = new List<int>();
+
         private NativeModuleRegistry(
             IList<ModuleDefinition> moduleTable,
             IDictionary<Type, INativeModule> moduleInstances)
@@ -22,6 +34,14 @@ namespace ReactNative.Bridge
                 .Select(moduleDefinition => moduleDefinition.Target)
                 .OfType<IOnBatchCompleteListener>()
                 .ToList();
+
+            var moduleConfigs = new Dictionary<string, Func<JToken>>(_moduleTable.Count);
+            foreach (var moduleDefinition in _moduleTable)
+            {
+                moduleConfigs.Add(moduleDefinition.Name, moduleDefinition.GetConfig);
+            }
+
+            ModuleConfigs = moduleConfigs;
         }
 
         public ICollection<INativeModule> Modules
@@ -32,6 +52,18 @@ namespace ReactNative.Bridge
             }
         }
 
+        /// <summary>
+        /// The JavaScript configuration of each module, by module name.
+        /// </summary>
+        /// <remarks>
+        /// Each configuration is built, and the module's methods and
+        /// constants with it, on the first call to its resolver, and is
+        /// cached after that. Pass this to
+        /// <see cref="IReactBridge.SetLazyGlobalVariable"/> so modules that
+        /// are never read from JavaScript stay uninitialized.
+        /// </remarks>
+        public IReadOnlyDictionary<string, Func<JToken>> ModuleConfigs { get; }
+
         public T GetModule<T>() where T : INativeModule
         {
             var instance = default(INativeModule);
@@ -43,34 +75,370 @@ namespace ReactNative.Bridge
             throw new InvalidOperationException("No module instance for type '{0}'.");
         }
 
+        public void Invoke(ICatalystInstance catalystInstance, int moduleId, int methodId, JArray parameters)
+        {
+            _moduleTable[moduleId].Invoke(catalystInstance, methodId, parameters);
+        }
+
+        public void InvokeBatch(ICatalystInstance catalystInstance, JArray batch)
+        {
+            if (batch == null)
+                throw new ArgumentNullException(nameof(batch));
+
+            //
+            // The queue flushed from JavaScript is a column-major triple:
+            // [moduleIds, methodIds, params], with one entry per call.
+            //
+            var moduleIds = batch.Count > 0 ? batch[0] as JArray : null;
+            var methodIds = batch.Count > 1 ? batch[1] as JArray : null;
+            var parameters = batch.Count > 2 ? batch[2] as JArray : null;
+            if (moduleIds == null || methodIds == null || parameters == null ||
+                moduleIds.Count != methodIds.Count || moduleIds.Count != parameters.Count)
+            {
+                throw new ArgumentException("Invalid native call batch.", nameof(batch));
+            }
+
+            var isTracing = ReactEventSource.Log.IsEnabled(ReactEventSource.Keywords.Batch);
+            if (isTracing)
+            {
+                ReactEventSource.Log.BatchStart(moduleIds.Count);
+            }
+
+            try
+            {
+                var callbacks = CallbackBatch.Begin();
+                try
+                {
+                    for (var i = 0; i < moduleIds.Count; ++i)
+                    {
+                        _moduleTable[moduleIds[i].Value<int>()].Invoke(
+                            catalystInstance,
+                            methodIds[i].Value<int>(),
+                            (JArray)parameters[i]);
+                    }
+                }
+                finally
+                {
+                    callbacks.End();
+
+                    // Listeners are told about a failed batch too, so work they
+                    // deferred to the end of the batch is not left behind.
+                    OnBatchComplete();
+                }
+            }
+            finally
+            {
+                // Paired with BatchStart even when a call throws.
+                if (isTracing)
+                {
+                    ReactEventSource.Log.BatchStop(moduleIds.Count);
+                }
+            }
+        }
+
+        public void InvokeBatch(ICatalystInstance catalystInstance, JsonReader reader)
+        {
+            if (reader == null)
+                throw new ArgumentNullException(nameof(reader));
+
+            //
+            // Module and method IDs precede the parameters in the flushed
+            // queue, so they are buffered before streaming each call's
+            // arguments straight from the reader into the native method.
+            //
+            var moduleIds = Interlocked.Exchange(ref _moduleIdBuffer, null) ?? new List<int>();
+            var methodIds = Interlocked.Exchange(ref _methodIdBuffer, null) ?? new List<int>();
+
+            ReadToken(reader, JsonToken.StartArray);
+            ReadIds(reader, moduleIds);
+            ReadIds(reader, methodIds);
+            ReadToken(reader, JsonToken.StartArray);
+
+            var count = moduleIds.Count;
+            if (count != methodIds.Count)
+            {
+                throw new ArgumentException("Invalid native call batch.", nameof(reader));
+            }
+
+            var isTracing = ReactEventSource.Log.IsEnabled(ReactEventSource.Keywords.Batch);
+            if (isTracing)
+            {
+                ReactEventSource.Log.BatchStart(count);
+            }
+
+            try
+            {
+                var callbacks = CallbackBatch.Begin();
+                try
+                {
+                    for (var i = 0; i < count; ++i)
+                    {
+                        ReadToken(reader, JsonToken.StartArray);
+
+                        var moduleDefinition = _moduleTable[moduleIds[i]];
+                        if (moduleDefinition.ActionQueue == null)
+                        {
+                            moduleDefinition.Invoke(catalystInstance, methodIds[i], reader);
+                        }
+                        else
+                        {
+                            // Calls that leave this thread cannot stream from the
+                            // reader, so their arguments are loaded first.
+                            moduleDefinition.Invoke(catalystInstance, methodIds[i], JArray.Load(reader));
+                        }
+                    }
+
+                    ReadToken(reader, JsonToken.EndArray);
+
+                    // Buffers lost to an exception are simply replaced next time.
+                    _moduleIdBuffer = moduleIds;
+                    _methodIdBuffer = methodIds;
+
+                    // Skip any trailing batch entries, such as the call ID.
+                    while (reader.Read() && reader.TokenType != JsonToken.EndArray)
+                    {
+                        reader.Skip();
+                    }
+                }
+                finally
+                {
+                    callbacks.End();
+
+                    // As above, listeners are told about a failed batch too.
+                    OnBatchComplete();
+                }
+            }
+            finally
+            {
+                // Paired with BatchStart even when a call throws.
+                if (isTracing)
+                {
+                    ReactEventSource.Log.BatchStop(count);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Creates the callback that the bridge hands the native calls
+        /// flushed from JavaScript to.
+        /// </summary>
+        /// <remarks>
+        /// Each batch is bound straight from the bridge's reader, on the
+        /// JavaScript thread, so the flushed queue is never loaded into a
+        /// JSON tree for modules without an action queue.
+        /// </remarks>
+        /// <param name="catalystInstance">The instance the calls are made for.</param>
+        /// <returns>The callback.</returns>
+        public IReactCallback CreateReactCallback(ICatalystInstance catalystInstance)
+        {
+            return new ReactCallback(this, catalystInstance);
+        }
+
+        private static void ReadIds(JsonReader reader, List<int> buffer)
+        {
+            buffer.Clear();
+            ReadToken(reader, JsonToken.StartArray);
+
+            var id = default(int?);
+            while ((id = reader.ReadAsInt32()).HasValue)
+            {
+                buffer.Add(id.Value);
+            }
+
+            if (reader.TokenType != JsonToken.EndArray)
+            {
+                throw new ArgumentException("Invalid native call batch.", nameof(reader));
+            }
+        }
+
+        private static void ReadToken(JsonReader reader, JsonToken expected)
+        {
+            if (!reader.Read() || reader.TokenType != expected)
+            {
+                throw new ArgumentException("Invalid native call batch.", nameof(reader));
+            }
+        }
+
+        private void OnBatchComplete()
+        {
+            foreach (var listener in _batchCompleteListenerModules)
+            {
+                //
+                // Listeners with their own queue are notified on it, after
+                // the calls from this batch that were queued before.
+                //
+                var actionQueue = ((INativeModule)listener).ActionQueue;
+                if (actionQueue == null)
+                {
+                    listener.OnBatchComplete();
+                }
+                else
+                {
+                    actionQueue.RunOnQueue(listener.OnBatchComplete);
+                }
+            }
+        }
+
+        class ReactCallback : IReactCallback
+        {
+            private readonly NativeModuleRegistry _registry;
+            private readonly ICatalystInstance _catalystInstance;
+
+            public ReactCallback(NativeModuleRegistry registry, ICatalystInstance catalystInstance)
+            {
+                _registry = registry;
+                _catalystInstance = catalystInstance;
+            }
+
+            public void Invoke(JsonReader batch)
+            {
+                _registry.InvokeBatch(_catalystInstance, batch);
+            }
+        }
+
         class ModuleDefinition
         {
             private readonly int _id;
             private readonly string _name;
-            private readonly IList<MethodRegistration> _methods;
+            private readonly Lazy<IList<MethodRegistration>> _methods;
+            private readonly Lazy<JObject> _config;
+            private readonly NativeModuleConstantsCache _constantsCache;
 
-            public ModuleDefinition(int id, string name, INativeModule target)
+            public ModuleDefinition(int id, string name, INativeModule target, NativeModuleConstantsCache constantsCache)
             {
                 _id = id;
                 _name = name;
+                _constantsCache = constantsCache;
                 Target = target;
-                _methods = new List<MethodRegistration>(target.Methods.Count);
+                ActionQueue = target.ActionQueue;
+
+                // The method table is only built when JavaScript first calls
+                // into the module.
+                _methods = new Lazy<IList<MethodRegistration>>(CreateMethods);
+                _config = new Lazy<JObject>(CreateConfig);
+            }
+
+            public string Name
+            {
+                get
+                {
+                    return _name;
+                }
+            }
+
+            public INativeModule Target { get; }
+
+            public IMessageQueueThread ActionQueue { get; }
+
+            public JToken GetConfig()
+            {
+                return _config.Value;
+            }
+
+            public void Invoke(ICatalystInstance catalystInstance, int methodId, JArray parameters)
+            {
+                if (ActionQueue == null)
+                {
+                    Invoke(_methods.Value[methodId], catalystInstance, parameters);
+                }
+                else
+                {
+                    ActionQueue.RunOnQueue(() => Invoke(_methods.Value[methodId], catalystInstance, parameters));
+                }
+            }
+
+            public void Invoke(ICatalystInstance catalystInstance, int methodId, JsonReader reader)
+            {
+                var method = _methods.Value[methodId];
+                if (!ReactEventSource.Log.IsEnabled(ReactEventSource.Keywords.NativeCall))
+                {
+                    method.Method.Invoke(catalystInstance, reader);
+                    return;
+                }
 
-                foreach (var entry in target.Methods)
+                ReactEventSource.Log.NativeCallStart(method.TracingName);
+                try
                 {
-                    _methods.Add(
+                    method.Method.Invoke(catalystInstance, reader);
+                }
+                finally
+                {
+                    ReactEventSource.Log.NativeCallStop(method.TracingName);
+                }
+            }
+
+            private static void Invoke(MethodRegistration method, ICatalystInstance catalystInstance, JArray parameters)
+            {
+                if (!ReactEventSource.Log.IsEnabled(ReactEventSource.Keywords.NativeCall))
+                {
+                    method.Method.Invoke(catalystInstance, parameters);
+                    return;
+                }
+
+                ReactEventSource.Log.NativeCallStart(method.TracingName);
+                try
+                {
+                    method.Method.Invoke(catalystInstance, parameters);
+                }
+                finally
+                {
+                    ReactEventSource.Log.NativeCallStop(method.TracingName);
+                }
+            }
+
+            private IList<MethodRegistration> CreateMethods()
+            {
+                var methods = new List<MethodRegistration>(Target.Methods.Count);
+                foreach (var entry in Target.Methods)
+                {
+                    methods.Add(
                         new MethodRegistration(
                             entry.Key,
-                            "NativeCall__" + target.Name + "_" + entry.Key,
+                            "NativeCall__" + _name + "_" + entry.Key,
                             entry.Value));
                 }
+
+                return methods;
             }
 
-            public INativeModule Target { get; }
+            private JObject CreateConfig()
+            {
+                var methods = new JObject();
+                var methodId = 0;
+                foreach (var method in _methods.Value)
+                {
+                    methods.Add(
+                        method.Name,
+                        new JObject
+                        {
+                            { "methodID", methodId++ },
+                            { "type", method.Method.Type },
+                        });
+                }
 
-            public void Invoke(ICatalystInstance catalystInstance, int methodId, JArray parameters)
+                return new JObject
+                {
+                    { "moduleID", _id },
+                    { "methods", methods },
+                    { "constants", CreateConstants() },
+                };
+            }
+
+            private JObject CreateConstants()
             {
-                _methods[methodId].Method.Invoke(catalystInstance, parameters);
+                if (_constantsCache == null || !Target.HasStableConstants)
+                {
+                    return JObject.FromObject(Target.Constants);
+                }
+
+                var constants = default(JObject);
+                if (!_constantsCache.TryGetConstants(_name, out constants))
+                {
+                    constants = JObject.FromObject(Target.Constants);
+                    _constantsCache.SetConstants(_name, constants);
+                }
+
+                return constants;
             }
 
             class MethodRegistration
@@ -95,6 +463,8 @@ namespace ReactNative.Bridge
             private readonly IDictionary<string, INativeModule> _modules = 
                 new Dictionary<string, INativeModule>();
 
+            private NativeModuleConstantsCache _constantsCache;
+
             public Builder Add(INativeModule module)
             {
                 if (module == null)
@@ -121,8 +491,22 @@ namespace ReactNative.Bridge
 
                 }
 
-                _modules.Add(module.Name, module);
+                _modules[module.Name] = module;
+
+                return this;
+            }
+
+            /// <summary>
+            /// Configures modules with stable constants from a cache.
+            /// </summary>
+            /// <param name="constantsCache">The cache.</param>
+            /// <returns>The builder.</returns>
+            public Builder SetConstantsCache(NativeModuleConstantsCache constantsCache)
+            {
+                if (constantsCache == null)
+                    throw new ArgumentNullException(nameof(constantsCache));
 
+                _constantsCache = constantsCache;
                 return this;
             }
 
@@ -134,7 +518,7 @@ namespace ReactNative.Bridge
                 var idx = 0;
                 foreach (var module in _modules.Values)
                 {
-                    var moduleDef = new ModuleDefinition(idx++, module.Name, module);
+                    var moduleDef = new ModuleDefinition(idx++, module.Name, module, _constantsCache);
                     moduleTable.Add(moduleDef);
                     moduleInstances.Add(module.GetType(), module);
                 }
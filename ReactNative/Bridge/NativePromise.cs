@@ -0,0 +1,75 @@
+﻿using Newtonsoft.Json.Linq;
+using System;
+using System.Threading.Tasks;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// Settles the JavaScript promise behind a <b>remoteAsync</b> native
+    /// method when the task it returned completes.
+    /// </summary>
+    /// <remarks>
+    /// The native modules queue is released as soon as the method returns
+    /// its task; the callbacks are invoked from wherever the task
+    /// completes.
+    /// </remarks>
+    public static class NativePromise
+    {
+        public static void Bind(Task task, ICallback resolve, ICallback reject)
+        {
+            if (task == null)
+                throw new ArgumentNullException(nameof(task));
+            if (resolve == null)
+                throw new ArgumentNullException(nameof(resolve));
+            if (reject == null)
+                throw new ArgumentNullException(nameof(reject));
+
+            task.ContinueWith(
+                t =>
+                {
+                    if (t.Status == TaskStatus.RanToCompletion)
+                    {
+                        resolve.Invoke();
+                    }
+                    else
+                    {
+                        reject.Invoke(CreateError(t));
+                    }
+                },
+                TaskContinuationOptions.ExecuteSynchronously);
+        }
+
+        public static void Bind<T>(Task<T> task, ICallback resolve, ICallback reject)
+        {
+            if (task == null)
+                throw new ArgumentNullException(nameof(task));
+            if (resolve == null)
+                throw new ArgumentNullException(nameof(resolve));
+            if (reject == null)
+                throw new ArgumentNullException(nameof(reject));
+
+            task.ContinueWith(
+                t =>
+                {
+                    if (t.Status == TaskStatus.RanToCompletion)
+                    {
+                        resolve.Invoke(new object[] { t.Result });
+                    }
+                    else
+                    {
+                        reject.Invoke(CreateError(t));
+                    }
+                },
+                TaskContinuationOptions.ExecuteSynchronously);
+        }
+
+        private static JObject CreateError(Task task)
+        {
+            var exception = task.Exception?.GetBaseException();
+            return new JObject
+            {
+                { "message", exception != null ? exception.Message : "Operation was canceled." },
+            };
+        }
+    }
+}
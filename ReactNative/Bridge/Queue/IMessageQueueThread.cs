@@ -15,18 +15,45 @@ namespace ReactNative.Bridge.Queue
         /// <param name="action">The action.</param>
         void RunOnQueue(Action action);
 
+        /// <summary>
+        /// Runs the given action on this thread in the given priority lane.
+        /// </summary>
+        /// <remarks>
+        /// Higher lanes are always served first, and the thread checks for
+        /// higher-lane work after each <see cref="MessageQueuePriority.Normal"/>
+        /// or <see cref="MessageQueuePriority.Idle"/> action.
+        /// </remarks>
+        /// <param name="action">The action.</param>
+        /// <param name="priority">The priority lane.</param>
+        void RunOnQueue(Action action, MessageQueuePriority priority);
+
         /// <summary>
         /// Invokes the given function on this thread.
         /// </summary>
         /// <remarks>
-        /// The function will be submitted to the end of the event queue
-        /// even if it is being submitted from the same queue Thread.
+        /// If called from this thread, the function is invoked immediately
+        /// and the returned task is already complete. Otherwise, the
+        /// function is submitted to the end of the event queue.
         /// </remarks>
         /// <typeparam name="T">The type of result expected.</typeparam>
         /// <param name="func">The function.</param>
         /// <returns>The result of the function.</returns>
         Task<T> CallOnQueue<T>(Func<T> func);
 
+        /// <summary>
+        /// Invokes the given function on this thread in the given priority
+        /// lane.
+        /// </summary>
+        /// <remarks>
+        /// As with <see cref="CallOnQueue{T}(Func{T})"/>, the function is
+        /// invoked immediately if called from this thread.
+        /// </remarks>
+        /// <typeparam name="T">The type of result expected.</typeparam>
+        /// <param name="func">The function.</param>
+        /// <param name="priority">The priority lane.</param>
+        /// <returns>The result of the function.</returns>
+        Task<T> CallOnQueue<T>(Func<T> func, MessageQueuePriority priority);
+
         /// <summary>
         /// Checks whether the current thread is also the thread 
         /// associated with this <see cref="IMessageQueueThread"/>.
@@ -0,0 +1,29 @@
+﻿namespace ReactNative.Bridge.Queue
+{
+    /// <summary>
+    /// The lanes of work on an <see cref="IMessageQueueThread"/>, from the
+    /// highest to the lowest priority.
+    /// </summary>
+    public enum MessageQueuePriority
+    {
+        /// <summary>
+        /// Work that must run before anything else, e.g., touch input.
+        /// </summary>
+        Immediate,
+
+        /// <summary>
+        /// Work the user is waiting on, e.g., animation frames.
+        /// </summary>
+        UserBlocking,
+
+        /// <summary>
+        /// The default lane.
+        /// </summary>
+        Normal,
+
+        /// <summary>
+        /// Work that only runs when every other lane is empty.
+        /// </summary>
+        Idle,
+    }
+}
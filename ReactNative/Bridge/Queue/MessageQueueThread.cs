@@ -1,43 +1,349 @@
-﻿using System;
+﻿using ReactNative.Hosting;
+using ReactNative.Tracing;
+using System;
 using System.Collections.Concurrent;
-using System.Collections.Generic;
+using System.Diagnostics;
+using System.Diagnostics.Tracing;
 using System.Globalization;
-using System.Linq;
-using System.Text;
+using System.Threading;
 using System.Threading.Tasks;
-using Windows.System.Threading;
+using Windows.ApplicationModel.Core;
+using Windows.UI.Core;
 
 namespace ReactNative.Bridge.Queue
 {
-    public abstract class MessageQueueThread : IMessageQueueThread
+    public abstract class MessageQueueThread : IMessageQueueThread, IDisposable
     {
-        protected readonly ConcurrentQueue<Action> _runOnQueueQueue =
-            new ConcurrentQueue<Action>();
+        private const int LaneCount = (int)MessageQueuePriority.Idle + 1;
+
+        private readonly ConcurrentQueue<Action>[] _runOnQueueQueues = CreateQueues();
+
+        private readonly IQueueThreadExceptionHandler _handler;
+
+        protected MessageQueueThread(string name, IQueueThreadExceptionHandler handler)
+        {
+            if (handler == null)
+                throw new ArgumentNullException(nameof(handler));
+
+            Name = name;
+            _handler = handler;
+        }
+
+        public string Name { get; }
 
         public abstract bool IsOnThread();
 
         public void RunOnQueue(Action action)
         {
-            _runOnQueueQueue.Enqueue(action);
+            RunOnQueue(action, MessageQueuePriority.Normal);
+        }
+
+        public void RunOnQueue(Action action, MessageQueuePriority priority)
+        {
+            if (action == null)
+                throw new ArgumentNullException(nameof(action));
+            if (priority < MessageQueuePriority.Immediate || priority > MessageQueuePriority.Idle)
+                throw new ArgumentOutOfRangeException(nameof(priority));
+
+            if (ReactEventSource.Log.IsEnabled(ReactEventSource.Keywords.Queue))
+            {
+                action = TraceAction(action, priority);
+            }
+
+            _runOnQueueQueues[(int)priority].Enqueue(action);
+            Schedule(priority);
+        }
+
+        public Task<T> CallOnQueue<T>(Func<T> func)
+        {
+            return CallOnQueue(func, MessageQueuePriority.Normal);
+        }
+
+        public Task<T> CallOnQueue<T>(Func<T> func, MessageQueuePriority priority)
+        {
+            if (func == null)
+                throw new ArgumentNullException(nameof(func));
+            if (priority < MessageQueuePriority.Immediate || priority > MessageQueuePriority.Idle)
+                throw new ArgumentOutOfRangeException(nameof(priority));
+
+            //
+            // Calls from the thread itself would otherwise wait behind all
+            // queued work for a result they can compute right away.
+            //
+            if (IsOnThread())
+            {
+                try
+                {
+                    return Task.FromResult(func());
+                }
+                catch (Exception ex)
+                {
+                    return Task.FromException<T>(TransformException(ex));
+                }
+            }
+
+            var workItem = new CallOnQueueWorkItem<T>(this, func);
+            RunOnQueue(workItem.Invoke, priority);
+            return workItem.Task;
         }
 
         public abstract void Start();
 
-        public MessageQueueThread Create(
+        public virtual void Dispose()
+        {
+        }
+
+        /// <summary>
+        /// Signals the thread that work has been added to the queue.
+        /// </summary>
+        /// <param name="priority">The lane the work was added to.</param>
+        protected abstract void Schedule(MessageQueuePriority priority);
+
+        /// <summary>
+        /// Gets a value indicating whether any lane has queued work.
+        /// </summary>
+        protected bool HasPendingWork
+        {
+            get
+            {
+                MessageQueuePriority priority;
+                return TryGetPendingPriority(out priority);
+            }
+        }
+
+        /// <summary>
+        /// Gets the highest lane that has queued work.
+        /// </summary>
+        /// <param name="priority">The lane.</param>
+        /// <returns>
+        /// <b>true</b> if any lane has queued work, <b>false</b> otherwise.
+        /// </returns>
+        protected bool TryGetPendingPriority(out MessageQueuePriority priority)
+        {
+            for (var i = 0; i < LaneCount; ++i)
+            {
+                if (!_runOnQueueQueues[i].IsEmpty)
+                {
+                    priority = (MessageQueuePriority)i;
+                    return true;
+                }
+            }
+
+            priority = MessageQueuePriority.Idle;
+            return false;
+        }
+
+        /// <summary>
+        /// Runs queued actions, highest lane first.
+        /// </summary>
+        /// <remarks>
+        /// <see cref="MessageQueuePriority.Immediate"/> and
+        /// <see cref="MessageQueuePriority.UserBlocking"/> work is drained
+        /// until those lanes are empty. The batch ends after a single action
+        /// from a lower lane, so the thread can pick up newly queued
+        /// higher-lane work before running the next one.
+        /// </remarks>
+        /// <returns>
+        /// <b>true</b> if any actions were run, <b>false</b> otherwise.
+        /// </returns>
+        protected bool DrainBatch()
+        {
+            var ran = false;
+            for (var i = 0; i < LaneCount; ++i)
+            {
+                var action = default(Action);
+                if (_runOnQueueQueues[i].TryDequeue(out action))
+                {
+                    ran = true;
+
+                    try
+                    {
+                        Invoke(action);
+                    }
+                    catch (Exception ex)
+                    {
+                        _handler.HandleException(ex);
+                    }
+
+                    if (i >= (int)MessageQueuePriority.Normal)
+                    {
+                        break;
+                    }
+
+                    // Start again from the highest lane.
+                    i = -1;
+                }
+            }
+
+            return ran;
+        }
+
+        protected void HandleException(Exception ex)
+        {
+            _handler.HandleException(ex);
+        }
+
+        /// <summary>
+        /// Replaces an exception thrown by queued work before it reaches the
+        /// caller of <see cref="CallOnQueue{T}(Func{T})"/>.
+        /// </summary>
+        /// <remarks>
+        /// Called on the thread while the action that threw is still
+        /// running, so the thread can add what it knows about the action.
+        /// </remarks>
+        /// <param name="ex">The exception.</param>
+        /// <returns>The exception to report.</returns>
+        protected virtual Exception TransformException(Exception ex)
+        {
+            return ex;
+        }
+
+        /// <summary>
+        /// Runs a queued action.
+        /// </summary>
+        /// <param name="action">The action.</param>
+        protected virtual void Invoke(Action action)
+        {
+            action();
+        }
+
+        /// <summary>
+        /// Removes all queued work without running it.
+        /// </summary>
+        /// <remarks>
+        /// Tasks returned by <see cref="CallOnQueue{T}(Func{T})"/> for the
+        /// removed work fault with an <see cref="ObjectDisposedException"/>,
+        /// so callers awaiting them do not hang.
+        /// </remarks>
+        protected void AbandonPendingWork()
+        {
+            for (var i = 0; i < LaneCount; ++i)
+            {
+                var action = default(Action);
+                while (_runOnQueueQueues[i].TryDequeue(out action))
+                {
+                    var tracedAction = action.Target as TracedAction;
+                    var workItem = (tracedAction?.Action ?? action).Target as ICallOnQueueWorkItem;
+                    workItem?.Abandon(Name);
+                }
+            }
+        }
+
+        private Action TraceAction(Action action, MessageQueuePriority priority)
+        {
+            var lane = (int)priority;
+            ReactEventSource.Log.QueueItemEnqueued(Name, lane);
+            return new TracedAction(Name, lane, action).Invoke;
+        }
+
+        private static ConcurrentQueue<Action>[] CreateQueues()
+        {
+            var queues = new ConcurrentQueue<Action>[LaneCount];
+            for (var i = 0; i < LaneCount; ++i)
+            {
+                queues[i] = new ConcurrentQueue<Action>();
+            }
+
+            return queues;
+        }
+
+        /// <summary>
+        /// Wraps a queued action with queue events, and keeps the action
+        /// reachable so abandoned work can still be identified.
+        /// </summary>
+        sealed class TracedAction
+        {
+            private readonly string _name;
+            private readonly int _lane;
+            private readonly long _enqueued = Stopwatch.GetTimestamp();
+
+            public TracedAction(string name, int lane, Action action)
+            {
+                _name = name;
+                _lane = lane;
+                Action = action;
+            }
+
+            public Action Action { get; }
+
+            public void Invoke()
+            {
+                var waitMilliseconds = (Stopwatch.GetTimestamp() - _enqueued) * 1000.0 / Stopwatch.Frequency;
+                ReactEventSource.Log.QueueItemStart(_name, _lane, waitMilliseconds);
+                try
+                {
+                    Action();
+                }
+                finally
+                {
+                    ReactEventSource.Log.QueueItemStop(_name, _lane);
+                }
+            }
+        }
+
+        interface ICallOnQueueWorkItem
+        {
+            void Abandon(string threadName);
+        }
+
+        /// <summary>
+        /// A completion source that is also the queued work item, so a call
+        /// needs no closure besides the delegate to <see cref="Invoke"/>.
+        /// </summary>
+        /// <remarks>
+        /// Continuations run asynchronously so that awaiting code does not
+        /// run on, and hold up, the queue thread.
+        /// </remarks>
+        sealed class CallOnQueueWorkItem<T> : TaskCompletionSource<T>, ICallOnQueueWorkItem
+        {
+            private readonly MessageQueueThread _thread;
+            private readonly Func<T> _func;
+
+            public CallOnQueueWorkItem(MessageQueueThread thread, Func<T> func)
+                : base(TaskCreationOptions.RunContinuationsAsynchronously)
+            {
+                _thread = thread;
+                _func = func;
+            }
+
+            public void Invoke()
+            {
+                try
+                {
+                    SetResult(_func());
+                }
+                catch (Exception ex)
+                {
+                    SetException(_thread.TransformException(ex));
+                }
+            }
+
+            public void Abandon(string threadName)
+            {
+                SetException(new ObjectDisposedException(threadName, "The message queue thread was disposed before the work ran."));
+            }
+        }
+
+        public static MessageQueueThread Create(
             MessageQueueThreadSpec spec,
             IQueueThreadExceptionHandler handler)
         {
+            if (spec == null)
+                throw new ArgumentNullException(nameof(spec));
+
             switch (spec.Kind)
             {
                 case MessageQueueThreadKind.MainUi:
-                    return new DispatcherMessageQueueThread(name, handler);
+                    return new DispatcherMessageQueueThread(spec.Name, handler);
                 case MessageQueueThreadKind.NewBackground:
-                    return new BackgroundMessageQueueThread(name, handler);
+                    return new PooledMessageQueueThread(spec.Name, handler);
+                case MessageQueueThreadKind.JavaScript:
+                    return new JavaScriptMessageQueueThread(spec.Name, handler, spec.WatchdogTimeout);
                 default:
                     throw new InvalidOperationException(
                         string.Format(
                             CultureInfo.InvariantCulture,
-                            "Unknown thread type '{0}' with name '{1}'.", 
+                            "Unknown thread type '{0}' with name '{1}'.",
                             spec.Kind,
                             spec.Name));
             }
@@ -45,9 +351,483 @@ namespace ReactNative.Bridge.Queue
 
         class DispatcherMessageQueueThread : MessageQueueThread
         {
+            private const int NotScheduled = LaneCount;
+
+            //
+            // A single dispatcher callback keeps draining batches until the
+            // queue is empty or it has used up its budget, so back-to-back
+            // work does not pay for a dispatcher round trip per action. The
+            // budget keeps the callback short enough not to delay input and
+            // rendering.
+            //
+            private const int MaxBatchesPerDrain = 64;
+            private static readonly long s_drainBudgetTicks = Stopwatch.Frequency * 8 / 1000;
+
+            private readonly CoreDispatcher _dispatcher;
+
+            private int _scheduledPriority = NotScheduled;
+
             public DispatcherMessageQueueThread(string name, IQueueThreadExceptionHandler handler)
+                : base(name, handler)
+            {
+                _dispatcher = CoreApplication.MainView.CoreWindow.Dispatcher;
+            }
+
+            public override bool IsOnThread()
+            {
+                return _dispatcher.HasThreadAccess;
+            }
+
+            public override void Start()
+            {
+                MessageQueuePriority priority;
+                if (TryGetPendingPriority(out priority))
+                {
+                    Schedule(priority);
+                }
+            }
+
+            protected override void Schedule(MessageQueuePriority priority)
+            {
+                //
+                // Coalesce pending work into a single dispatcher callback,
+                // unless the new work needs a higher dispatcher priority
+                // than the callback already scheduled.
+                //
+                var lane = (int)priority;
+                var scheduled = Volatile.Read(ref _scheduledPriority);
+                while (lane < scheduled)
+                {
+                    var previous = Interlocked.CompareExchange(ref _scheduledPriority, lane, scheduled);
+                    if (previous == scheduled)
+                    {
+                        var ignored = _dispatcher.RunAsync(GetDispatcherPriority(priority), Drain);
+                        return;
+                    }
+
+                    scheduled = previous;
+                }
+            }
+
+            private void Drain()
             {
+                Volatile.Write(ref _scheduledPriority, NotScheduled);
 
+                var deadline = Stopwatch.GetTimestamp() + s_drainBudgetTicks;
+                for (var i = 0; i < MaxBatchesPerDrain && Stopwatch.GetTimestamp() < deadline; ++i)
+                {
+                    if (!DrainBatch())
+                    {
+                        break;
+                    }
+                }
+
+                MessageQueuePriority priority;
+                if (TryGetPendingPriority(out priority))
+                {
+                    Schedule(priority);
+                }
+            }
+
+            private static CoreDispatcherPriority GetDispatcherPriority(MessageQueuePriority priority)
+            {
+                switch (priority)
+                {
+                    case MessageQueuePriority.Immediate:
+                    case MessageQueuePriority.UserBlocking:
+                        return CoreDispatcherPriority.High;
+                    case MessageQueuePriority.Idle:
+                        return CoreDispatcherPriority.Idle;
+                    default:
+                        return CoreDispatcherPriority.Normal;
+                }
+            }
+        }
+
+        /// <summary>
+        /// A serial queue that runs on the thread pool instead of its own
+        /// thread.
+        /// </summary>
+        /// <remarks>
+        /// At most one drain of the queue is scheduled at a time, so actions
+        /// keep their order and never run concurrently. Drains started from
+        /// a pool thread go to that thread's local queue, where idle pool
+        /// threads steal them from.
+        /// </remarks>
+        class PooledMessageQueueThread : MessageQueueThread
+        {
+            //
+            // Bounds how long one queue holds on to a pool thread while
+            // other queues are waiting, without rescheduling after every
+            // action.
+            //
+            private const int MaxBatchesPerDrain = 16;
+
+            private static readonly Action<object> s_drain = state => ((PooledMessageQueueThread)state).Drain();
+
+            [ThreadStatic]
+            private static PooledMessageQueueThread s_current;
+
+            private int _scheduled;
+            private int _started;
+            private volatile bool _disposed;
+
+            public PooledMessageQueueThread(string name, IQueueThreadExceptionHandler handler)
+                : base(name, handler)
+            {
+            }
+
+            public override bool IsOnThread()
+            {
+                return s_current == this;
+            }
+
+            public override void Start()
+            {
+                if (Interlocked.Exchange(ref _started, 1) != 0)
+                {
+                    throw new InvalidOperationException("Message queue thread has already been started.");
+                }
+
+                if (HasPendingWork)
+                {
+                    Schedule(MessageQueuePriority.Normal);
+                }
+            }
+
+            public override void Dispose()
+            {
+                _disposed = true;
+                AbandonPendingWork();
+            }
+
+            protected override void Schedule(MessageQueuePriority priority)
+            {
+                if (_disposed)
+                {
+                    // Nothing will run work queued after disposal.
+                    AbandonPendingWork();
+                    return;
+                }
+
+                if (Volatile.Read(ref _started) == 0)
+                {
+                    return;
+                }
+
+                if (Interlocked.CompareExchange(ref _scheduled, 1, 0) == 0)
+                {
+                    Task.Factory.StartNew(s_drain, this, CancellationToken.None, TaskCreationOptions.DenyChildAttach, TaskScheduler.Default);
+                }
+            }
+
+            private void Drain()
+            {
+                var previous = s_current;
+                s_current = this;
+                try
+                {
+                    for (var i = 0; i < MaxBatchesPerDrain && !_disposed; ++i)
+                    {
+                        if (!DrainBatch())
+                        {
+                            break;
+                        }
+                    }
+                }
+                finally
+                {
+                    s_current = previous;
+
+                    // Work queued after the last batch may have found the
+                    // drain still scheduled, so check again once released.
+                    Volatile.Write(ref _scheduled, 0);
+                    if (HasPendingWork)
+                    {
+                        Schedule(MessageQueuePriority.Normal);
+                    }
+                }
+            }
+        }
+
+        class BackgroundMessageQueueThread : MessageQueueThread
+        {
+            private readonly AutoResetEvent _workAvailable = new AutoResetEvent(false);
+
+            private int _threadId = -1;
+            private int _started;
+            private volatile bool _disposed;
+
+            public BackgroundMessageQueueThread(string name, IQueueThreadExceptionHandler handler)
+                : base(name, handler)
+            {
+            }
+
+            public override bool IsOnThread()
+            {
+                return Environment.CurrentManagedThreadId == _threadId;
+            }
+
+            public override void Start()
+            {
+                if (Interlocked.Exchange(ref _started, 1) != 0)
+                {
+                    throw new InvalidOperationException("Message queue thread has already been started.");
+                }
+
+                Task.Factory.StartNew(Run, CancellationToken.None, TaskCreationOptions.LongRunning, TaskScheduler.Default);
+            }
+
+            public override void Dispose()
+            {
+                _disposed = true;
+                _workAvailable.Set();
+                AbandonPendingWork();
+            }
+
+            protected override void Schedule(MessageQueuePriority priority)
+            {
+                if (_disposed)
+                {
+                    // Nothing will run work queued after disposal.
+                    AbandonPendingWork();
+                    return;
+                }
+
+                _workAvailable.Set();
+            }
+
+            /// <summary>
+            /// Called on the thread before any work is run.
+            /// </summary>
+            protected virtual void OnStart()
+            {
+            }
+
+            /// <summary>
+            /// Called on the thread each time the queue has been emptied.
+            /// </summary>
+            /// <returns>
+            /// The maximum time, in milliseconds, to wait for new work before
+            /// calling <see cref="OnIdle"/> again, or <see cref="Timeout.Infinite"/>.
+            /// </returns>
+            protected virtual int OnIdle()
+            {
+                return Timeout.Infinite;
+            }
+
+            /// <summary>
+            /// Called on the thread after it has been disposed.
+            /// </summary>
+            protected virtual void OnStop()
+            {
+            }
+
+            private void Run()
+            {
+                _threadId = Environment.CurrentManagedThreadId;
+
+                //
+                // The event is left for the finalizer, since callers may
+                // still signal it after the thread has stopped. OnStop runs
+                // even if the exception handler rethrows, so resources
+                // created in OnStart are released.
+                //
+                try
+                {
+                    OnStart();
+
+                    while (!_disposed)
+                    {
+                        if (!DrainBatch() && !HasPendingWork)
+                        {
+                            _workAvailable.WaitOne(OnIdle());
+                        }
+                    }
+                }
+                catch (Exception ex)
+                {
+                    HandleException(ex);
+                }
+                finally
+                {
+                    OnStop();
+                }
+            }
+        }
+
+        class JavaScriptMessageQueueThread : BackgroundMessageQueueThread
+        {
+            private readonly TimeSpan _watchdogTimeout;
+            private readonly object _watchdogGate = new object();
+
+            private JavaScriptRuntime _runtime;
+            private JavaScriptContext.Scope _scope;
+
+            private Timer _watchdog;
+            private long _actionStart;
+            private bool _isInterrupted;
+
+            public JavaScriptMessageQueueThread(string name, IQueueThreadExceptionHandler handler, TimeSpan watchdogTimeout)
+                : base(name, handler)
+            {
+                _watchdogTimeout = watchdogTimeout;
+            }
+
+            protected override void OnStart()
+            {
+                //
+                // The thread owns the runtime and keeps its context current
+                // for its whole lifetime. Idle processing lets the runtime
+                // defer collection work to the gaps between batches.
+                //
+                var attributes = JavaScriptRuntimeAttributes.EnableIdleProcessing;
+                if (_watchdogTimeout != Timeout.InfiniteTimeSpan)
+                {
+                    attributes |= JavaScriptRuntimeAttributes.AllowScriptInterrupt;
+                }
+
+                _runtime = JavaScriptRuntime.Create(attributes, JavaScriptRuntimeVersion.Version11);
+                _scope = new JavaScriptContext.Scope(_runtime.CreateContext());
+
+                if (_watchdogTimeout != Timeout.InfiniteTimeSpan)
+                {
+                    var period = TimeSpan.FromTicks(Math.Max(_watchdogTimeout.Ticks / 2, TimeSpan.TicksPerMillisecond));
+                    _watchdog = new Timer(CheckWatchdog, null, period, period);
+                }
+            }
+
+            protected override void Invoke(Action action)
+            {
+                if (_watchdog == null)
+                {
+                    action();
+                    return;
+                }
+
+                var actionStart = Stopwatch.GetTimestamp();
+                lock (_watchdogGate)
+                {
+                    _actionStart = actionStart;
+                }
+
+                try
+                {
+                    action();
+                }
+                catch (JavaScriptScriptException ex) when (IsInterruption(ex))
+                {
+                    throw CreateInterruptedException(ex, actionStart);
+                }
+                finally
+                {
+                    lock (_watchdogGate)
+                    {
+                        _actionStart = 0;
+                        if (_isInterrupted)
+                        {
+                            _isInterrupted = false;
+                            _runtime.Disabled = false;
+                        }
+                    }
+                }
+            }
+
+            protected override Exception TransformException(Exception ex)
+            {
+                var scriptException = ex as JavaScriptScriptException;
+                if (scriptException == null || !IsInterruption(scriptException))
+                {
+                    return ex;
+                }
+
+                var actionStart = default(long);
+                lock (_watchdogGate)
+                {
+                    actionStart = _actionStart;
+                }
+
+                return CreateInterruptedException(scriptException, actionStart);
+            }
+
+            protected override int OnIdle()
+            {
+                var nextIdleTick = JavaScriptContext.Idle();
+                if (nextIdleTick == uint.MaxValue)
+                {
+                    return Timeout.Infinite;
+                }
+
+                var delay = unchecked((int)(nextIdleTick - (uint)Environment.TickCount));
+                return delay > 0 ? delay : 0;
+            }
+
+            protected override void OnStop()
+            {
+                lock (_watchdogGate)
+                {
+                    _watchdog?.Dispose();
+                    _watchdog = null;
+                }
+
+                _scope.Dispose();
+                _runtime.Dispose();
+            }
+
+            private void CheckWatchdog(object state)
+            {
+                var elapsedMilliseconds = default(double);
+                lock (_watchdogGate)
+                {
+                    if (_watchdog == null || _actionStart == 0 || _isInterrupted)
+                    {
+                        return;
+                    }
+
+                    elapsedMilliseconds = GetElapsedMilliseconds(_actionStart);
+                    if (elapsedMilliseconds < _watchdogTimeout.TotalMilliseconds)
+                    {
+                        return;
+                    }
+
+                    //
+                    // Disabling execution is the one runtime call allowed
+                    // from another thread. Running script stops at its next
+                    // interrupt check, and the runtime is enabled again once
+                    // the action has unwound.
+                    //
+                    _isInterrupted = true;
+                    _runtime.Disabled = true;
+                }
+
+                if (ReactEventSource.Log.IsEnabled(EventLevel.Warning, ReactEventSource.Keywords.Queue))
+                {
+                    ReactEventSource.Log.ScriptInterrupted(Name, elapsedMilliseconds);
+                }
+            }
+
+            private bool IsInterruption(JavaScriptScriptException ex)
+            {
+                return ex.ErrorCode == JavaScriptErrorCode.ScriptTerminated && Volatile.Read(ref _isInterrupted);
+            }
+
+            private JavaScriptScriptException CreateInterruptedException(JavaScriptScriptException ex, long actionStart)
+            {
+                // The runtime cannot report where a terminated script was,
+                // so the error says which thread and for how long.
+                return new JavaScriptScriptException(
+                    ex.ErrorCode,
+                    ex.Error,
+                    string.Format(
+                        CultureInfo.InvariantCulture,
+                        "Script on thread '{0}' was interrupted by the watchdog after {1:F0}ms.",
+                        Name,
+                        GetElapsedMilliseconds(actionStart)));
+            }
+
+            private static double GetElapsedMilliseconds(long start)
+            {
+                return (Stopwatch.GetTimestamp() - start) * 1000.0 / Stopwatch.Frequency;
             }
         }
     }
@@ -1,5 +1,4 @@
 ﻿using System;
-using System.Threading.Tasks;
 
 namespace ReactNative.Bridge.Queue
 {
@@ -19,18 +18,5 @@ namespace ReactNative.Bridge.Queue
                 throw new InvalidOperationException("Thread access assertion failed.");
             }
         }
-
-        public Task<T> CallOnQueue<T>(this IMessageQueueThread actionQueue, Func<T> func)
-        {
-            var taskCompletionSource = new TaskCompletionSource<T>();
-
-            actionQueue.RunOnQueue(async () =>
-            {
-                var result = func;
-                await ThreadPool.RunAsync(taskCompletionSource.SetResult(result));
-            });
-
-            return taskCompletionSource.Task;
-        }
     }
 }
@@ -4,6 +4,7 @@
     {
         MainUi,
         NewBackground,
+        JavaScript,
     }
 
 }
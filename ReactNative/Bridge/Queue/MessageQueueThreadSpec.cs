@@ -1,34 +1,64 @@
 ﻿using System;
-using System.Collections.Generic;
-using System.Linq;
-using System.Text;
-using System.Threading.Tasks;
+using System.Threading;
 
 namespace ReactNative.Bridge.Queue
 {
     public class MessageQueueThreadSpec
     {
         private MessageQueueThreadSpec(MessageQueueThreadKind kind, string name)
+            : this(kind, name, Timeout.InfiniteTimeSpan)
+        {
+        }
+
+        private MessageQueueThreadSpec(MessageQueueThreadKind kind, string name, TimeSpan watchdogTimeout)
         {
             Name = name;
             Kind = kind;
+            WatchdogTimeout = watchdogTimeout;
         }
 
         public string Name { get; }
 
+        /// <summary>
+        /// How long a single action on a JavaScript thread may run before
+        /// its script is interrupted, or <see cref="Timeout.InfiniteTimeSpan"/>.
+        /// </summary>
+        public TimeSpan WatchdogTimeout { get; }
+
         internal MessageQueueThreadKind Kind { get; }
 
-        public static MessageQueueThreadSpec MainUiThreadSpec { get; } = new MessageQueueThreadSpec(MessageQueueThreadKind.MainUi, "main_ui")
+        public static MessageQueueThreadSpec MainUiThreadSpec { get; } = new MessageQueueThreadSpec(MessageQueueThreadKind.MainUi, "main_ui");
+
+        public static MessageQueueThreadSpec JavaScriptThreadSpec { get; } = new MessageQueueThreadSpec(MessageQueueThreadKind.JavaScript, "js");
 
+        /// <summary>
+        /// Creates a spec for a background queue.
+        /// </summary>
+        /// <remarks>
+        /// Background queues are serial, but share the thread pool rather
+        /// than each having a thread of their own.
+        /// </remarks>
+        /// <param name="name">The queue name.</param>
+        /// <returns>The spec.</returns>
         public static MessageQueueThreadSpec Create(string name)
         {
             return new MessageQueueThreadSpec(MessageQueueThreadKind.NewBackground, name);
         }
 
-        enum MessageQueueThreadKind
+        /// <summary>
+        /// Creates a spec for a JavaScript thread with a watchdog.
+        /// </summary>
+        /// <param name="name">The thread name.</param>
+        /// <param name="watchdogTimeout">
+        /// How long a single action may run before its script is interrupted.
+        /// </param>
+        /// <returns>The spec.</returns>
+        public static MessageQueueThreadSpec CreateJavaScript(string name, TimeSpan watchdogTimeout)
         {
-            MainUi,
-            NewBackground,
+            if (watchdogTimeout <= TimeSpan.Zero && watchdogTimeout != Timeout.InfiniteTimeSpan)
+                throw new ArgumentOutOfRangeException(nameof(watchdogTimeout));
+
+            return new MessageQueueThreadSpec(MessageQueueThreadKind.JavaScript, name, watchdogTimeout);
         }
     }
 }
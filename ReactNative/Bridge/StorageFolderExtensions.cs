@@ -0,0 +1,34 @@
+﻿using System;
+using System.Threading.Tasks;
+using Windows.Storage;
+
+namespace ReactNative.Bridge
+{
+    static class StorageFolderExtensions
+    {
+        /// <summary>
+        /// Writes a file under a temporary name, and renames it into place
+        /// once it is complete, so readers never see a partial file.
+        /// </summary>
+        /// <param name="folder">The folder.</param>
+        /// <param name="fileName">The file name.</param>
+        /// <param name="write">Writes the contents of the temporary file.</param>
+        /// <returns>A task to await the write.</returns>
+        public static async Task ReplaceFileAsync(this StorageFolder folder, string fileName, Func<StorageFile, Task> write)
+        {
+            // Unique, so concurrent writers of the same file do not collide.
+            var file = await folder.CreateFileAsync(fileName + ".tmp", CreationCollisionOption.GenerateUniqueName);
+            try
+            {
+                await write(file);
+                await file.RenameAsync(fileName, NameCollisionOption.ReplaceExisting);
+            }
+            catch
+            {
+                // Best effort; the original failure is the one to report.
+                var ignored = file.DeleteAsync(StorageDeleteOption.PermanentDelete);
+                throw;
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+﻿using ReactNative.Hosting;
+using System;
+using System.Collections;
+using System.Runtime.InteropServices;
+
+namespace ReactNative.Bridge
+{
+    /// <summary>
+    /// An array of numbers that is passed to JavaScript as a typed array,
+    /// such as a <c>Float64Array</c>, instead of a plain <c>Array</c>.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Plain .NET arrays are always passed as JavaScript arrays. Wrap an
+    /// array to opt in when the JavaScript side expects a typed array, for
+    /// example to hand it to a WebGL or audio API. The typed array is
+    /// created and filled with a single copy, rather than one call per
+    /// element.
+    /// </para>
+    /// <para>
+    /// The values are copied when the argument is marshaled, so do not
+    /// change the array until the call has been made.
+    /// </para>
+    /// </remarks>
+    public sealed class TypedArray
+    {
+        private readonly Action<IntPtr> _copy;
+
+        /// <summary>
+        /// Wraps the values to be passed as a <c>Uint8Array</c>.
+        /// </summary>
+        /// <param name="values">The values.</param>
+        public TypedArray(byte[] values)
+            : this(values, JavaScriptTypedArrayType.Uint8, storage => Marshal.Copy(values, 0, storage, values.Length))
+        {
+        }
+
+        /// <summary>
+        /// Wraps the values to be passed as an <c>Int32Array</c>.
+        /// </summary>
+        /// <param name="values">The values.</param>
+        public TypedArray(int[] values)
+            : this(values, JavaScriptTypedArrayType.Int32, storage => Marshal.Copy(values, 0, storage, values.Length))
+        {
+        }
+
+        /// <summary>
+        /// Wraps the values to be passed as a <c>Float32Array</c>.
+        /// </summary>
+        /// <param name="values">The values.</param>
+        public TypedArray(float[] values)
+            : this(values, JavaScriptTypedArrayType.Float32, storage => Marshal.Copy(values, 0, storage, values.Length))
+        {
+        }
+
+        /// <summary>
+        /// Wraps the values to be passed as a <c>Float64Array</c>.
+        /// </summary>
+        /// <param name="values">The values.</param>
+        public TypedArray(double[] values)
+            : this(values, JavaScriptTypedArrayType.Float64, storage => Marshal.Copy(values, 0, storage, values.Length))
+        {
+        }
+
+        private TypedArray(Array values, JavaScriptTypedArrayType arrayType, Action<IntPtr> copy)
+        {
+            if (values == null)
+                throw new ArgumentNullException(nameof(values));
+
+            Values = values;
+            ArrayType = arrayType;
+            _copy = copy;
+        }
+
+        internal IList Values { get; }
+
+        internal JavaScriptTypedArrayType ArrayType { get; }
+
+        internal void CopyTo(IntPtr storage)
+        {
+            _copy(storage);
+        }
+    }
+}
@@ -192,6 +192,33 @@
             return result;
         }
 
+        /// <summary>
+        ///     Parses a serialized script held in native memory and returns a <c>Function</c>
+        ///     representing the script.
+        /// </summary>
+        /// <remarks>
+        ///     <para>
+        ///     The runtime holds on to both buffers until all functions generated from them are
+        ///     garbage collected, so they must remain valid until the runtime is disposed.
+        ///     </para>
+        ///     <para>
+        ///     Requires an active script context.
+        ///     </para>
+        /// </remarks>
+        /// <param name="script">A pointer to the null-terminated UTF-16 source of the script.</param>
+        /// <param name="buffer">A pointer to the serialized script.</param>
+        /// <param name="sourceContext">
+        ///     A cookie identifying the script that can be used by script contexts that have debugging enabled.
+        /// </param>
+        /// <param name="sourceName">The location the script came from.</param>
+        /// <returns>A <c>Function</c> representing the script code.</returns>
+        public static JavaScriptValue ParseScript(IntPtr script, IntPtr buffer, JavaScriptSourceContext sourceContext, string sourceName)
+        {
+            JavaScriptValue result;
+            Native.ThrowIfError(Native.JsParseSerializedScript(script, buffer, sourceContext, sourceName, out result));
+            return result;
+        }
+
         /// <summary>
         ///     Parses a script and returns a <c>Function</c> representing the script.
         /// </summary>
@@ -258,6 +285,32 @@
             return result;
         }
 
+        /// <summary>
+        ///     Runs a serialized script held in native memory.
+        /// </summary>
+        /// <remarks>
+        ///     <para>
+        ///     The runtime holds on to both buffers until all functions generated from them are
+        ///     garbage collected, so they must remain valid until the runtime is disposed.
+        ///     </para>
+        ///     <para>
+        ///     Requires an active script context.
+        ///     </para>
+        /// </remarks>
+        /// <param name="script">A pointer to the null-terminated UTF-16 source of the script.</param>
+        /// <param name="buffer">A pointer to the serialized script.</param>
+        /// <param name="sourceContext">
+        ///     A cookie identifying the script that can be used by script contexts that have debugging enabled.
+        /// </param>
+        /// <param name="sourceName">The location the script came from.</param>
+        /// <returns>The result of the script, if any.</returns>
+        public static JavaScriptValue RunScript(IntPtr script, IntPtr buffer, JavaScriptSourceContext sourceContext, string sourceName)
+        {
+            JavaScriptValue result;
+            Native.ThrowIfError(Native.JsRunSerializedScript(script, buffer, sourceContext, sourceName, out result));
+            return result;
+        }
+
         /// <summary>
         ///     Executes a script.
         /// </summary>
@@ -305,7 +358,7 @@
         /// </returns>
         public static ulong SerializeScript(string script, byte[] buffer)
         {
-            var bufferSize = (ulong)buffer.Length;
+            var bufferSize = buffer != null ? (ulong)buffer.Length : 0;
             Native.ThrowIfError(Native.JsSerializeScript(script, buffer, ref bufferSize));
             return bufferSize;
         }
@@ -73,6 +73,35 @@
             return id;
         }
 
+        /// <summary>
+        ///     Adds a reference to the property ID.
+        /// </summary>
+        /// <remarks>
+        ///     Calling AddRef ensures that the property ID will not be freed until Release is called,
+        ///     so it can be kept and reused across calls.
+        /// </remarks>
+        /// <returns>The property ID's new reference count.</returns>
+        public uint AddRef()
+        {
+            uint count;
+            Native.ThrowIfError(Native.JsPropertyIdAddRef(this, out count));
+            return count;
+        }
+
+        /// <summary>
+        ///     Releases a reference to the property ID.
+        /// </summary>
+        /// <remarks>
+        ///     Removes a reference that was created by AddRef.
+        /// </remarks>
+        /// <returns>The property ID's new reference count.</returns>
+        public uint Release()
+        {
+            uint count;
+            Native.ThrowIfError(Native.JsPropertyIdRelease(this, out count));
+            return count;
+        }
+
         /// <summary>
         ///     The equality operator for property IDs.
         /// </summary>
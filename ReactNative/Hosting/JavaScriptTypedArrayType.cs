@@ -0,0 +1,53 @@
+﻿namespace ReactNative.Hosting
+{
+    /// <summary>
+    ///     The type of a typed JavaScript array.
+    /// </summary>
+    public enum JavaScriptTypedArrayType
+    {
+        /// <summary>
+        ///     An int8 array.
+        /// </summary>
+        Int8 = 0,
+
+        /// <summary>
+        ///     An uint8 array.
+        /// </summary>
+        Uint8 = 1,
+
+        /// <summary>
+        ///     An uint8 clamped array.
+        /// </summary>
+        Uint8Clamped = 2,
+
+        /// <summary>
+        ///     An int16 array.
+        /// </summary>
+        Int16 = 3,
+
+        /// <summary>
+        ///     An uint16 array.
+        /// </summary>
+        Uint16 = 4,
+
+        /// <summary>
+        ///     An int32 array.
+        /// </summary>
+        Int32 = 5,
+
+        /// <summary>
+        ///     An uint32 array.
+        /// </summary>
+        Uint32 = 6,
+
+        /// <summary>
+        ///     A float32 array.
+        /// </summary>
+        Float32 = 7,
+
+        /// <summary>
+        ///     A float64 array.
+        /// </summary>
+        Float64 = 8,
+    }
+}
@@ -383,6 +383,115 @@
             return reference;
         }
 
+        /// <summary>
+        ///     Creates a JavaScript ArrayBuffer object.
+        /// </summary>
+        /// <remarks>
+        ///     Requires an active script context.
+        /// </remarks>
+        /// <param name="byteLength">The number of bytes in the buffer.</param>
+        /// <returns>The new ArrayBuffer object.</returns>
+        public static JavaScriptValue CreateArrayBuffer(uint byteLength)
+        {
+            JavaScriptValue reference;
+            Native.ThrowIfError(Native.JsCreateArrayBuffer(byteLength, out reference));
+            return reference;
+        }
+
+        /// <summary>
+        ///     Creates a JavaScript ArrayBuffer object over external memory.
+        /// </summary>
+        /// <remarks>
+        ///     <para>
+        ///     The memory is not copied, and must stay valid until the finalizer is called.
+        ///     </para>
+        ///     <para>
+        ///     Requires an active script context.
+        ///     </para>
+        /// </remarks>
+        /// <param name="data">The memory of the buffer.</param>
+        /// <param name="byteLength">The number of bytes in the buffer.</param>
+        /// <param name="finalizer">
+        ///     A callback for when the buffer is finalized. May be null.
+        /// </param>
+        /// <param name="callbackState">The state passed to the finalizer.</param>
+        /// <returns>The new ArrayBuffer object.</returns>
+        public static JavaScriptValue CreateExternalArrayBuffer(IntPtr data, uint byteLength, JavaScriptObjectFinalizeCallback finalizer, IntPtr callbackState)
+        {
+            JavaScriptValue reference;
+            Native.ThrowIfError(Native.JsCreateExternalArrayBuffer(data, byteLength, finalizer, callbackState, out reference));
+            return reference;
+        }
+
+        /// <summary>
+        ///     Creates a JavaScript typed array object.
+        /// </summary>
+        /// <remarks>
+        ///     <para>
+        ///     If <paramref name="baseArray"/> is invalid, a new zero-filled typed array with
+        ///     <paramref name="elementLength"/> elements is created. Otherwise it is a view over the
+        ///     ArrayBuffer, typed array or array.
+        ///     </para>
+        ///     <para>
+        ///     Requires an active script context.
+        ///     </para>
+        /// </remarks>
+        /// <param name="arrayType">The type of the array.</param>
+        /// <param name="baseArray">The base array of the new array, or <c>Invalid</c>.</param>
+        /// <param name="byteOffset">The offset in bytes from the start of the base array.</param>
+        /// <param name="elementLength">The number of elements in the array.</param>
+        /// <returns>The new typed array object.</returns>
+        public static JavaScriptValue CreateTypedArray(JavaScriptTypedArrayType arrayType, JavaScriptValue baseArray, uint byteOffset, uint elementLength)
+        {
+            JavaScriptValue reference;
+            Native.ThrowIfError(Native.JsCreateTypedArray(arrayType, baseArray, byteOffset, elementLength, out reference));
+            return reference;
+        }
+
+        /// <summary>
+        ///     Gets the storage of an ArrayBuffer object.
+        /// </summary>
+        /// <remarks>
+        ///     <para>
+        ///     The storage is owned by the runtime and is only valid while the ArrayBuffer is
+        ///     alive.
+        ///     </para>
+        ///     <para>
+        ///     Requires an active script context.
+        ///     </para>
+        /// </remarks>
+        /// <param name="bufferLength">The number of bytes in the buffer.</param>
+        /// <returns>A pointer to the storage.</returns>
+        public IntPtr GetArrayBufferStorage(out uint bufferLength)
+        {
+            IntPtr buffer;
+            Native.ThrowIfError(Native.JsGetArrayBufferStorage(this, out buffer, out bufferLength));
+            return buffer;
+        }
+
+        /// <summary>
+        ///     Gets the storage of a typed array object.
+        /// </summary>
+        /// <remarks>
+        ///     <para>
+        ///     The storage is owned by the runtime and is only valid while the typed array is
+        ///     alive.
+        ///     </para>
+        ///     <para>
+        ///     Requires an active script context.
+        ///     </para>
+        /// </remarks>
+        /// <param name="bufferLength">The number of bytes in the array.</param>
+        /// <param name="arrayType">The type of the array.</param>
+        /// <param name="elementSize">The size of each element, in bytes.</param>
+        /// <returns>A pointer to the storage.</returns>
+        public IntPtr GetTypedArrayStorage(out uint bufferLength, out JavaScriptTypedArrayType arrayType, out int elementSize)
+        {
+            IntPtr buffer;
+            Native.ThrowIfError(Native.JsGetTypedArrayStorage(this, out buffer, out bufferLength, out arrayType, out elementSize));
+            return buffer;
+        }
+
         /// <summary>
         ///     Creates a new JavaScript error object
         /// </summary>
@@ -841,6 +950,79 @@
             return equals;
         }
 
+        /// <summary>
+        ///     Invokes a function with only a <c>this</c> argument.
+        /// </summary>
+        /// <remarks>
+        ///     Requires an active script context. Unlike the <c>params</c> overload, this does not
+        ///     allocate an argument array.
+        /// </remarks>
+        /// <param name="thisArg">The <c>this</c> argument of the call.</param>
+        /// <returns>The <c>Value</c> returned from the function invocation, if any.</returns>
+        public JavaScriptValue CallFunction(JavaScriptValue thisArg)
+        {
+            JavaScriptValue returnReference;
+            Native.ThrowIfError(Native.JsCallFunction(this, ref thisArg, 1, out returnReference));
+            return returnReference;
+        }
+
+        /// <summary>
+        ///     Invokes a function with one argument.
+        /// </summary>
+        /// <remarks>
+        ///     Requires an active script context. Unlike the <c>params</c> overload, this does not
+        ///     allocate an argument array.
+        /// </remarks>
+        /// <param name="thisArg">The <c>this</c> argument of the call.</param>
+        /// <param name="argument1">The first argument.</param>
+        /// <returns>The <c>Value</c> returned from the function invocation, if any.</returns>
+        public JavaScriptValue CallFunction(JavaScriptValue thisArg, JavaScriptValue argument1)
+        {
+            JavaScriptValue returnReference;
+            var arguments = new Arguments2(thisArg, argument1);
+            Native.ThrowIfError(Native.JsCallFunction(this, ref arguments.Argument0, 2, out returnReference));
+            return returnReference;
+        }
+
+        /// <summary>
+        ///     Invokes a function with two arguments.
+        /// </summary>
+        /// <remarks>
+        ///     Requires an active script context. Unlike the <c>params</c> overload, this does not
+        ///     allocate an argument array.
+        /// </remarks>
+        /// <param name="thisArg">The <c>this</c> argument of the call.</param>
+        /// <param name="argument1">The first argument.</param>
+        /// <param name="argument2">The second argument.</param>
+        /// <returns>The <c>Value</c> returned from the function invocation, if any.</returns>
+        public JavaScriptValue CallFunction(JavaScriptValue thisArg, JavaScriptValue argument1, JavaScriptValue argument2)
+        {
+            JavaScriptValue returnReference;
+            var arguments = new Arguments3(thisArg, argument1, argument2);
+            Native.ThrowIfError(Native.JsCallFunction(this, ref arguments.Argument0, 3, out returnReference));
+            return returnReference;
+        }
+
+        /// <summary>
+        ///     Invokes a function with three arguments.
+        /// </summary>
+        /// <remarks>
+        ///     Requires an active script context. Unlike the <c>params</c> overload, this does not
+        ///     allocate an argument array.
+        /// </remarks>
+        /// <param name="thisArg">The <c>this</c> argument of the call.</param>
+        /// <param name="argument1">The first argument.</param>
+        /// <param name="argument2">The second argument.</param>
+        /// <param name="argument3">The third argument.</param>
+        /// <returns>The <c>Value</c> returned from the function invocation, if any.</returns>
+        public JavaScriptValue CallFunction(JavaScriptValue thisArg, JavaScriptValue argument1, JavaScriptValue argument2, JavaScriptValue argument3)
+        {
+            JavaScriptValue returnReference;
+            var arguments = new Arguments4(thisArg, argument1, argument2, argument3);
+            Native.ThrowIfError(Native.JsCallFunction(this, ref arguments.Argument0, 4, out returnReference));
+            return returnReference;
+        }
+
         /// <summary>
         ///     Invokes a function.
         /// </summary>
@@ -882,5 +1064,59 @@
             Native.ThrowIfError(Native.JsConstructObject(this, arguments, (ushort)arguments.Length, out returnReference));
             return returnReference;
         }
+
+        /// <summary>
+        ///     Two call arguments, laid out contiguously on the stack.
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        private struct Arguments2
+        {
+            public JavaScriptValue Argument0;
+            public JavaScriptValue Argument1;
+
+            public Arguments2(JavaScriptValue argument0, JavaScriptValue argument1)
+            {
+                Argument0 = argument0;
+                Argument1 = argument1;
+            }
+        }
+
+        /// <summary>
+        ///     Three call arguments, laid out contiguously on the stack.
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        private struct Arguments3
+        {
+            public JavaScriptValue Argument0;
+            public JavaScriptValue Argument1;
+            public JavaScriptValue Argument2;
+
+            public Arguments3(JavaScriptValue argument0, JavaScriptValue argument1, JavaScriptValue argument2)
+            {
+                Argument0 = argument0;
+                Argument1 = argument1;
+                Argument2 = argument2;
+            }
+        }
+
+        /// <summary>
+        ///     Four call arguments, laid out contiguously on the stack.
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        private struct Arguments4
+        {
+            public JavaScriptValue Argument0;
+            public JavaScriptValue Argument1;
+            public JavaScriptValue Argument2;
+            public JavaScriptValue Argument3;
+
+            public Arguments4(JavaScriptValue argument0, JavaScriptValue argument1, JavaScriptValue argument2, JavaScriptValue argument3)
+            {
+                Argument0 = argument0;
+                Argument1 = argument1;
+                Argument2 = argument2;
+                Argument3 = argument3;
+            }
+        }
     }
 }
@@ -256,8 +256,81 @@
         /// </summary>
         [SuppressMessage("StyleCop.CSharp.DocumentationRules", "SA1650:ElementDocumentationMustBeSpelledCorrectly", Justification = "Name defined in COM.")]
         [Guid("32E4694E-0D37-419B-B93D-FA20DED6E8EA")]
+        [InterfaceType(ComInterfaceType.InterfaceIsIUnknown)]
         public interface IActiveScriptProfilerHeapEnum
         {
+            /// <summary>
+            ///     Gets the next objects on the heap.
+            /// </summary>
+            /// <param name="celt">The number of objects to get.</param>
+            /// <param name="heapObjects">
+            ///     Receives pointers to <see cref="ProfilerHeapObject"/> structures, which must be freed
+            ///     with <see cref="FreeObjectAndOptionalInfo"/>.
+            /// </param>
+            /// <param name="fetched">The number of objects received, zero at the end of the heap.</param>
+            void Next(uint celt, [Out, MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 0)] IntPtr[] heapObjects, out uint fetched);
+
+            /// <summary>
+            ///     Gets the optional information of a heap object.
+            /// </summary>
+            /// <param name="heapObject">The heap object.</param>
+            /// <param name="celt">The number of entries to get.</param>
+            /// <param name="optionalInfo">Receives the entries.</param>
+            void GetOptionalInfo(IntPtr heapObject, uint celt, IntPtr optionalInfo);
+
+            /// <summary>
+            ///     Frees heap objects received from <see cref="Next"/>.
+            /// </summary>
+            /// <param name="celt">The number of objects.</param>
+            /// <param name="heapObjects">The objects.</param>
+            void FreeObjectAndOptionalInfo(uint celt, [In, MarshalAs(UnmanagedType.LPArray, SizeParamIndex = 0)] IntPtr[] heapObjects);
+
+            /// <summary>
+            ///     Gets the names that heap objects refer to by ID.
+            /// </summary>
+            /// <param name="nameList">
+            ///     Receives an array of string pointers, indexed by name ID, which must be freed with
+            ///     <c>CoTaskMemFree</c>.
+            /// </param>
+            /// <param name="count">The number of names.</param>
+            void GetNameIdMap(out IntPtr nameList, out uint count);
+        }
+
+        /// <summary>
+        ///     An object on the heap, as returned by <see cref="IActiveScriptProfilerHeapEnum"/>.
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        public struct ProfilerHeapObject
+        {
+            /// <summary>
+            ///     The size of the object, in bytes.
+            /// </summary>
+            public uint Size;
+
+            /// <summary>
+            ///     The ID of the object.
+            /// </summary>
+            public IntPtr ObjectId;
+
+            /// <summary>
+            ///     The name ID of the object's type.
+            /// </summary>
+            public uint TypeNameId;
+
+            /// <summary>
+            ///     The object flags.
+            /// </summary>
+            public uint Flags;
+
+            /// <summary>
+            ///     Unused.
+            /// </summary>
+            public ushort Unused;
+
+            /// <summary>
+            ///     The number of optional information entries.
+            /// </summary>
+            public ushort OptionalInfoCount;
         }
 
         /// <summary>
@@ -398,12 +471,18 @@
         [DllImport("chakra.dll")]
         internal static extern JavaScriptErrorCode JsAddRef(JavaScriptValue reference, out uint count);
 
+        [DllImport("chakra.dll", EntryPoint = "JsAddRef")]
+        internal static extern JavaScriptErrorCode JsPropertyIdAddRef(JavaScriptPropertyId reference, out uint count);
+
         [DllImport("chakra.dll", EntryPoint = "JsRelease")]
         internal static extern JavaScriptErrorCode JsContextRelease(JavaScriptContext reference, out uint count);
 
         [DllImport("chakra.dll")]
         internal static extern JavaScriptErrorCode JsRelease(JavaScriptValue reference, out uint count);
 
+        [DllImport("chakra.dll", EntryPoint = "JsRelease")]
+        internal static extern JavaScriptErrorCode JsPropertyIdRelease(JavaScriptPropertyId reference, out uint count);
+
         [DllImport("chakra.dll")]
         internal static extern JavaScriptErrorCode JsCreateContext(JavaScriptRuntime runtime, IDebugApplication64 debugSite, out JavaScriptContext newContext);
 
@@ -443,6 +522,12 @@
         [DllImport("chakra.dll")]
         internal static extern JavaScriptErrorCode JsRunSerializedScript(string script, byte[] buffer, JavaScriptSourceContext sourceContext, string sourceUrl, out JavaScriptValue result);
 
+        [DllImport("chakra.dll")]
+        internal static extern JavaScriptErrorCode JsParseSerializedScript(IntPtr script, IntPtr buffer, JavaScriptSourceContext sourceContext, string sourceUrl, out JavaScriptValue result);
+
+        [DllImport("chakra.dll")]
+        internal static extern JavaScriptErrorCode JsRunSerializedScript(IntPtr script, IntPtr buffer, JavaScriptSourceContext sourceContext, string sourceUrl, out JavaScriptValue result);
+
         [DllImport("chakra.dll")]
         internal static extern JavaScriptErrorCode JsGetPropertyIdFromName(string name, out JavaScriptPropertyId propertyId);
 
@@ -578,9 +663,27 @@
         [DllImport("chakra.dll")]
         internal static extern JavaScriptErrorCode JsCreateArray(uint length, out JavaScriptValue result);
 
+        [DllImport("chakra.dll")]
+        internal static extern JavaScriptErrorCode JsCreateArrayBuffer(uint byteLength, out JavaScriptValue result);
+
+        [DllImport("chakra.dll")]
+        internal static extern JavaScriptErrorCode JsCreateExternalArrayBuffer(IntPtr data, uint byteLength, JavaScriptObjectFinalizeCallback finalizeCallback, IntPtr callbackState, out JavaScriptValue result);
+
+        [DllImport("chakra.dll")]
+        internal static extern JavaScriptErrorCode JsCreateTypedArray(JavaScriptTypedArrayType arrayType, JavaScriptValue baseArray, uint byteOffset, uint elementLength, out JavaScriptValue result);
+
+        [DllImport("chakra.dll")]
+        internal static extern JavaScriptErrorCode JsGetArrayBufferStorage(JavaScriptValue arrayBuffer, out IntPtr buffer, out uint bufferLength);
+
+        [DllImport("chakra.dll")]
+        internal static extern JavaScriptErrorCode JsGetTypedArrayStorage(JavaScriptValue typedArray, out IntPtr buffer, out uint bufferLength, out JavaScriptTypedArrayType arrayType, out int elementSize);
+
         [DllImport("chakra.dll")]
         internal static extern JavaScriptErrorCode JsCallFunction(JavaScriptValue function, JavaScriptValue[] arguments, ushort argumentCount, out JavaScriptValue result);
 
+        [DllImport("chakra.dll")]
+        internal static extern JavaScriptErrorCode JsCallFunction(JavaScriptValue function, ref JavaScriptValue arguments, ushort argumentCount, out JavaScriptValue result);
+
         [DllImport("chakra.dll")]
         internal static extern JavaScriptErrorCode JsConstructObject(JavaScriptValue function, JavaScriptValue[] arguments, ushort argumentCount, out JavaScriptValue result);
 
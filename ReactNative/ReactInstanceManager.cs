@@ -1,13 +1,189 @@
-﻿using System;
-using System.Collections.Generic;
-using System.Linq;
-using System.Text;
+﻿using ReactNative.Bridge;
+using ReactNative.Bridge.Queue;
+using System;
 using System.Threading.Tasks;
 
 namespace ReactNative
 {
     public abstract class ReactInstanceManager
     {
+        // The global the core bundle reads the native module configuration from.
+        private const string ModuleConfigName = "__fbBatchedBridgeConfig";
+
+        private MessageQueueThread _jsQueueThread;
+        private JavaScriptInstancePool _pool;
+        private JavaScriptMemoryGovernor _memoryGovernor;
+        private CatalystInstance _catalystInstance;
+
+        /// <summary>
+        /// The governor of the JavaScript heap of the current instance, or
+        /// <b>null</b> if no instance is running.
+        /// </summary>
+        public JavaScriptMemoryGovernor MemoryGovernor
+        {
+            get
+            {
+                return _memoryGovernor;
+            }
+        }
+
+        /// <summary>
+        /// Sets up the JavaScript thread and starts a React instance on it.
+        /// </summary>
+        /// <remarks>
+        /// The memory governor is started as soon as the instance has a
+        /// context, so the heap is governed while the bundle runs. If any
+        /// step fails, everything set up so far is torn down again.
+        /// </remarks>
+        /// <param name="exceptionHandler">The handler for JavaScript thread exceptions.</param>
+        /// <param name="coreBundleLoader">The loader for the core bundle.</param>
+        /// <param name="bundleLoader">The loader for the application bundle.</param>
+        /// <param name="registry">The native module registry.</param>
+        /// <returns>The running instance.</returns>
+        protected async Task<CatalystInstance> StartInstanceAsync(
+            IQueueThreadExceptionHandler exceptionHandler,
+            JavaScriptBundleLoader coreBundleLoader,
+            JavaScriptBundleLoader bundleLoader,
+            NativeModuleRegistry registry)
+        {
+            if (exceptionHandler == null)
+                throw new ArgumentNullException(nameof(exceptionHandler));
+            if (coreBundleLoader == null)
+                throw new ArgumentNullException(nameof(coreBundleLoader));
+            if (bundleLoader == null)
+                throw new ArgumentNullException(nameof(bundleLoader));
+            if (registry == null)
+                throw new ArgumentNullException(nameof(registry));
+            if (_jsQueueThread != null)
+                throw new InvalidOperationException("A React instance is already running.");
+
+            _jsQueueThread = MessageQueueThread.Create(MessageQueueThreadSpec.JavaScriptThreadSpec, exceptionHandler);
+            _jsQueueThread.Start();
+            try
+            {
+                _pool = new JavaScriptInstancePool(_jsQueueThread, coreBundleLoader, 0);
+                _catalystInstance = new CatalystInstance(registry);
+                await _catalystInstance.AcquireAsync(_pool);
+
+                // The governor attaches to the runtime through the instance's context.
+                _memoryGovernor = new JavaScriptMemoryGovernor(_catalystInstance.JSQueueThread, registry.Modules);
+                _memoryGovernor.Start();
+
+                await RunBundleAsync(_catalystInstance, bundleLoader, registry);
+            }
+            catch
+            {
+                await StopInstanceAsync();
+                throw;
+            }
+
+            return _catalystInstance;
+        }
+
+        /// <summary>
+        /// Tears down the React instance and its JavaScript thread.
+        /// </summary>
+        /// <returns>A task to await the teardown.</returns>
+        protected async Task StopInstanceAsync()
+        {
+            var jsQueueThread = _jsQueueThread;
+            if (jsQueueThread == null)
+            {
+                return;
+            }
+
+            //
+            // The governor detaches and the instances release their contexts
+            // on the JavaScript thread, in that order, so the thread is only
+            // disposed once the work they queued has run.
+            //
+            _memoryGovernor?.Dispose();
+            _catalystInstance?.Dispose();
+            _pool?.Dispose();
+            await jsQueueThread.CallOnQueue(() => true);
+            jsQueueThread.Dispose();
+
+            _memoryGovernor = null;
+            _catalystInstance = null;
+            _pool = null;
+            _jsQueueThread = null;
+        }
+
+        /// <summary>
+        /// Reads and parses the bundle off the UI thread, so that startup
+        /// can initialize the native modules while the splash screen is
+        /// still showing.
+        /// </summary>
+        /// <remarks>
+        /// The returned action runs the parsed bundle, and must be queued on
+        /// the JavaScript thread only after the module configuration has
+        /// been set on the bridge.
+        /// </remarks>
+        /// <param name="jsQueueThread">The JavaScript thread.</param>
+        /// <param name="bundleLoader">The bundle loader.</param>
+        /// <param name="bridge">The bridge.</param>
+        /// <returns>The action to run the bundle.</returns>
+        protected static async Task<Action> PrepareBundleAsync(
+            IMessageQueueThread jsQueueThread,
+            JavaScriptBundleLoader bundleLoader,
+            IReactBridge bridge)
+        {
+            if (jsQueueThread == null)
+                throw new ArgumentNullException(nameof(jsQueueThread));
+            if (bundleLoader == null)
+                throw new ArgumentNullException(nameof(bundleLoader));
+            if (bridge == null)
+                throw new ArgumentNullException(nameof(bridge));
+
+            await bundleLoader.InitializeAsync().ConfigureAwait(false);
+            return await jsQueueThread.CallOnQueue(() => bundleLoader.ParseScript(bridge)).ConfigureAwait(false);
+        }
+
+        /// <summary>
+        /// Runs the bundle in a React instance.
+        /// </summary>
+        /// <remarks>
+        /// The bundle is read and parsed while the native modules are
+        /// initialized, and only runs once the module configuration has been
+        /// set on the bridge.
+        /// </remarks>
+        /// <param name="catalystInstance">The instance.</param>
+        /// <param name="bundleLoader">The bundle loader.</param>
+        /// <param name="registry">The native module registry of the instance.</param>
+        /// <returns>A task to await the bundle.</returns>
+        protected static async Task RunBundleAsync(
+            CatalystInstance catalystInstance,
+            JavaScriptBundleLoader bundleLoader,
+            NativeModuleRegistry registry)
+        {
+            if (catalystInstance == null)
+                throw new ArgumentNullException(nameof(catalystInstance));
+            if (bundleLoader == null)
+                throw new ArgumentNullException(nameof(bundleLoader));
+            if (registry == null)
+                throw new ArgumentNullException(nameof(registry));
+
+            var prepareBundleTask = PrepareBundleAsync(catalystInstance.JSQueueThread, bundleLoader, catalystInstance.Bridge);
+            try
+            {
+                catalystInstance.Initialize();
+            }
+            finally
+            {
+                // The bundle is not left parsing on the JavaScript thread
+                // of an instance that is about to be disposed.
+                await prepareBundleTask.ConfigureAwait(false);
+            }
+
+            var runBundle = await prepareBundleTask.ConfigureAwait(false);
+            await catalystInstance.JSQueueThread.CallOnQueue(() =>
+            {
+                catalystInstance.Bridge.SetLazyGlobalVariable(ModuleConfigName, registry.ModuleConfigs);
+                runBundle();
+                return true;
+            }).ConfigureAwait(false);
+        }
+
         public sealed class Builder
         {
 
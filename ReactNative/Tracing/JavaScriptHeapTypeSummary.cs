@@ -0,0 +1,24 @@
+﻿namespace ReactNative.Tracing
+{
+    /// <summary>
+    /// The objects of one type in a JavaScript heap snapshot.
+    /// </summary>
+    public sealed class JavaScriptHeapTypeSummary
+    {
+        public JavaScriptHeapTypeSummary(string typeName, int objectCount, long size)
+        {
+            TypeName = typeName;
+            ObjectCount = objectCount;
+            Size = size;
+        }
+
+        public string TypeName { get; }
+
+        public int ObjectCount { get; }
+
+        /// <summary>
+        /// The total size of the objects, in bytes.
+        /// </summary>
+        public long Size { get; }
+    }
+}
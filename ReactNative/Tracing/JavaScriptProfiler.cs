@@ -0,0 +1,312 @@
+﻿using Newtonsoft.Json;
+using ReactNative.Bridge.Queue;
+using ReactNative.Hosting;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Threading.Tasks;
+
+namespace ReactNative.Tracing
+{
+    /// <summary>
+    /// Records JavaScript function calls and heap snapshots on a JavaScript
+    /// thread, e.g., on request from a developer menu or remote command.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The runtime reports every entry to and exit from a script function,
+    /// rather than samples, so script runs slower while recording. Events
+    /// go into a buffer allocated up front, and are dropped once the buffer
+    /// is full.
+    /// </para>
+    /// <para>
+    /// Recordings are exported in the Chrome trace event format, which
+    /// trace viewers and flame graph tools such as speedscope read.
+    /// </para>
+    /// </remarks>
+    public sealed class JavaScriptProfiler
+    {
+        private const int DefaultCapacity = 1 << 20;
+
+        private readonly IMessageQueueThread _jsQueueThread;
+        private readonly ProfileEvent[] _events;
+        private readonly Dictionary<long, string> _functionNames = new Dictionary<long, string>();
+        private readonly ProfilerCallback _callback;
+
+        private int _eventCount;
+        private long _droppedEventCount;
+        private volatile bool _isProfiling;
+
+        public JavaScriptProfiler(IMessageQueueThread jsQueueThread)
+            : this(jsQueueThread, DefaultCapacity)
+        {
+        }
+
+        /// <summary>
+        /// Instantiates the <see cref="JavaScriptProfiler"/>.
+        /// </summary>
+        /// <param name="jsQueueThread">The JavaScript thread.</param>
+        /// <param name="capacity">The number of events to buffer.</param>
+        public JavaScriptProfiler(IMessageQueueThread jsQueueThread, int capacity)
+        {
+            if (jsQueueThread == null)
+                throw new ArgumentNullException(nameof(jsQueueThread));
+            if (capacity <= 0)
+                throw new ArgumentOutOfRangeException(nameof(capacity));
+
+            _jsQueueThread = jsQueueThread;
+            _events = new ProfileEvent[capacity];
+            _callback = new ProfilerCallback(this);
+        }
+
+        public bool IsProfiling
+        {
+            get
+            {
+                return _isProfiling;
+            }
+        }
+
+        /// <summary>
+        /// The number of events dropped from the last recording because the
+        /// buffer was full.
+        /// </summary>
+        public long DroppedEventCount
+        {
+            get
+            {
+                return _droppedEventCount;
+            }
+        }
+
+        /// <summary>
+        /// Starts a new recording, discarding the previous one.
+        /// </summary>
+        /// <returns>A task to await the start.</returns>
+        public Task StartAsync()
+        {
+            return _jsQueueThread.CallOnQueue(() =>
+            {
+                if (_isProfiling)
+                {
+                    throw new InvalidOperationException("Profiler has already been started.");
+                }
+
+                _eventCount = 0;
+                _droppedEventCount = 0;
+                _functionNames.Clear();
+                JavaScriptContext.StartProfiling(_callback, Native.ProfilerEventMask.TraceScriptFunctionCall, 0);
+                _isProfiling = true;
+                return true;
+            });
+        }
+
+        /// <summary>
+        /// Stops the recording.
+        /// </summary>
+        /// <returns>A task to await the stop.</returns>
+        public Task StopAsync()
+        {
+            return _jsQueueThread.CallOnQueue(() =>
+            {
+                if (_isProfiling)
+                {
+                    JavaScriptContext.StopProfiling(0);
+                    _isProfiling = false;
+                }
+
+                return true;
+            });
+        }
+
+        /// <summary>
+        /// Writes the last recording as a Chrome trace.
+        /// </summary>
+        /// <param name="writer">The writer.</param>
+        public void WriteTrace(TextWriter writer)
+        {
+            if (writer == null)
+                throw new ArgumentNullException(nameof(writer));
+            if (_isProfiling)
+                throw new InvalidOperationException("Profiler must be stopped before the trace is written.");
+
+            using (var jsonWriter = new JsonTextWriter(writer))
+            {
+                jsonWriter.CloseOutput = false;
+                jsonWriter.WriteStartObject();
+                jsonWriter.WritePropertyName("traceEvents");
+                jsonWriter.WriteStartArray();
+
+                var start = _eventCount > 0 ? _events[0].Timestamp : 0;
+                for (var i = 0; i < _eventCount; ++i)
+                {
+                    var @event = _events[i];
+                    var name = default(string);
+                    if (!_functionNames.TryGetValue(@event.FunctionKey, out name))
+                    {
+                        name = "(anonymous)";
+                    }
+
+                    jsonWriter.WriteStartObject();
+                    jsonWriter.WritePropertyName("name");
+                    jsonWriter.WriteValue(name);
+                    jsonWriter.WritePropertyName("ph");
+                    jsonWriter.WriteValue(@event.IsEnter ? "B" : "E");
+                    jsonWriter.WritePropertyName("ts");
+                    jsonWriter.WriteValue((@event.Timestamp - start) * 1000000.0 / Stopwatch.Frequency);
+                    jsonWriter.WritePropertyName("pid");
+                    jsonWriter.WriteValue(1);
+                    jsonWriter.WritePropertyName("tid");
+                    jsonWriter.WriteValue(1);
+                    jsonWriter.WriteEndObject();
+                }
+
+                jsonWriter.WriteEndArray();
+                jsonWriter.WriteEndObject();
+            }
+        }
+
+        /// <summary>
+        /// Takes a snapshot of the heap of the JavaScript thread's context.
+        /// </summary>
+        /// <returns>The objects on the heap, by type, largest first.</returns>
+        public Task<IReadOnlyList<JavaScriptHeapTypeSummary>> TakeHeapSnapshotAsync()
+        {
+            return _jsQueueThread.CallOnQueue<IReadOnlyList<JavaScriptHeapTypeSummary>>(TakeHeapSnapshot);
+        }
+
+        private static IReadOnlyList<JavaScriptHeapTypeSummary> TakeHeapSnapshot()
+        {
+            var counts = new Dictionary<uint, int>();
+            var sizes = new Dictionary<uint, long>();
+            var names = default(string[]);
+
+            // The context cannot change until the enumerator is released.
+            var enumerator = JavaScriptContext.EnumerateHeap();
+            try
+            {
+                var nameList = default(IntPtr);
+                var nameCount = default(uint);
+                enumerator.GetNameIdMap(out nameList, out nameCount);
+                names = new string[nameCount];
+                for (var i = 0; i < nameCount; ++i)
+                {
+                    names[i] = Marshal.PtrToStringUni(Marshal.ReadIntPtr(nameList, i * IntPtr.Size));
+                }
+
+                Marshal.FreeCoTaskMem(nameList);
+
+                var heapObjects = new IntPtr[256];
+                var fetched = default(uint);
+                while (true)
+                {
+                    enumerator.Next((uint)heapObjects.Length, heapObjects, out fetched);
+                    if (fetched == 0)
+                    {
+                        break;
+                    }
+
+                    for (var i = 0; i < fetched; ++i)
+                    {
+                        var heapObject = Marshal.PtrToStructure<Native.ProfilerHeapObject>(heapObjects[i]);
+                        var count = default(int);
+                        var size = default(long);
+                        counts.TryGetValue(heapObject.TypeNameId, out count);
+                        sizes.TryGetValue(heapObject.TypeNameId, out size);
+                        counts[heapObject.TypeNameId] = count + 1;
+                        sizes[heapObject.TypeNameId] = size + heapObject.Size;
+                    }
+
+                    enumerator.FreeObjectAndOptionalInfo(fetched, heapObjects);
+                }
+            }
+            finally
+            {
+                Marshal.ReleaseComObject(enumerator);
+            }
+
+            return counts
+                .Select(entry => new JavaScriptHeapTypeSummary(
+                    entry.Key < names.Length ? names[entry.Key] : null,
+                    entry.Value,
+                    sizes[entry.Key]))
+                .OrderByDescending(summary => summary.Size)
+                .ToList();
+        }
+
+        private void Record(int scriptId, int functionId, bool isEnter)
+        {
+            if (_eventCount == _events.Length)
+            {
+                _droppedEventCount++;
+                return;
+            }
+
+            _events[_eventCount++] = new ProfileEvent(Stopwatch.GetTimestamp(), GetFunctionKey(scriptId, functionId), isEnter);
+        }
+
+        private static long GetFunctionKey(int scriptId, int functionId)
+        {
+            return ((long)scriptId << 32) | (uint)functionId;
+        }
+
+        struct ProfileEvent
+        {
+            public ProfileEvent(long timestamp, long functionKey, bool isEnter)
+            {
+                Timestamp = timestamp;
+                FunctionKey = functionKey;
+                IsEnter = isEnter;
+            }
+
+            public long Timestamp { get; }
+
+            public long FunctionKey { get; }
+
+            public bool IsEnter { get; }
+        }
+
+        /// <summary>
+        /// Receives the profiling events, on the JavaScript thread.
+        /// </summary>
+        sealed class ProfilerCallback : Native.IActiveScriptProfilerCallback
+        {
+            private readonly JavaScriptProfiler _profiler;
+
+            public ProfilerCallback(JavaScriptProfiler profiler)
+            {
+                _profiler = profiler;
+            }
+
+            public void Initialize(uint context)
+            {
+            }
+
+            public void Shutdown(uint reason)
+            {
+            }
+
+            public void ScriptCompiled(int scriptId, Native.ProfilerScriptType type, IntPtr debugDocumentContext)
+            {
+            }
+
+            public void FunctionCompiled(int functionId, int scriptId, string functionName, string functionNameHint, IntPtr debugDocumentContext)
+            {
+                _profiler._functionNames[GetFunctionKey(scriptId, functionId)] = functionName ?? functionNameHint;
+            }
+
+            public void OnFunctionEnter(int scriptId, int functionId)
+            {
+                _profiler.Record(scriptId, functionId, true);
+            }
+
+            public void OnFunctionExit(int scriptId, int functionId)
+            {
+                _profiler.Record(scriptId, functionId, false);
+            }
+        }
+    }
+}
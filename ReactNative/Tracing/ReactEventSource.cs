@@ -0,0 +1,134 @@
+﻿using System.Diagnostics.Tracing;
+
+namespace ReactNative.Tracing
+{
+    /// <summary>
+    /// Trace events for the bridge hot paths and the JavaScript heap.
+    /// </summary>
+    /// <remarks>
+    /// Events are only written while an ETW session or event listener has
+    /// enabled the source, so callers guard each event with a single check
+    /// when tracing is off. Verbose events are guarded with
+    /// <see cref="IsEnabled(EventKeywords)"/>, and events at other levels
+    /// with <see cref="EventSource.IsEnabled(EventLevel, EventKeywords)"/>
+    /// and their own level, so that sessions below verbose still get them.
+    /// </remarks>
+    [EventSource(Name = "ReactNative-Bridge")]
+    public sealed class ReactEventSource : EventSource
+    {
+        public static readonly ReactEventSource Log = new ReactEventSource();
+
+        private ReactEventSource()
+        {
+        }
+
+        public static class Keywords
+        {
+            public const EventKeywords Queue = (EventKeywords)0x1;
+            public const EventKeywords NativeCall = (EventKeywords)0x2;
+            public const EventKeywords Batch = (EventKeywords)0x4;
+            public const EventKeywords Memory = (EventKeywords)0x8;
+            public const EventKeywords Cache = (EventKeywords)0x10;
+        }
+
+        public static class Tasks
+        {
+            public const EventTask QueueItem = (EventTask)1;
+            public const EventTask NativeCall = (EventTask)2;
+            public const EventTask Batch = (EventTask)3;
+        }
+
+        /// <summary>
+        /// Checks whether any of the given keywords are being traced at the
+        /// verbose level.
+        /// </summary>
+        /// <param name="keywords">The keywords.</param>
+        /// <returns>
+        /// <b>true</b> if events for the keywords should be written,
+        /// <b>false</b> otherwise.
+        /// </returns>
+        [NonEvent]
+        public bool IsEnabled(EventKeywords keywords)
+        {
+            return IsEnabled(EventLevel.Verbose, keywords);
+        }
+
+        [Event(1, Keywords = Keywords.Queue, Level = EventLevel.Verbose, Task = Tasks.QueueItem, Opcode = EventOpcode.Send)]
+        public void QueueItemEnqueued(string queueName, int priority)
+        {
+            WriteEvent(1, queueName, priority);
+        }
+
+        [Event(2, Keywords = Keywords.Queue, Level = EventLevel.Verbose, Task = Tasks.QueueItem, Opcode = EventOpcode.Start)]
+        public void QueueItemStart(string queueName, int priority, double waitMilliseconds)
+        {
+            WriteEvent(2, queueName, priority, waitMilliseconds);
+        }
+
+        [Event(3, Keywords = Keywords.Queue, Level = EventLevel.Verbose, Task = Tasks.QueueItem, Opcode = EventOpcode.Stop)]
+        public void QueueItemStop(string queueName, int priority)
+        {
+            WriteEvent(3, queueName, priority);
+        }
+
+        [Event(4, Keywords = Keywords.NativeCall, Level = EventLevel.Verbose, Task = Tasks.NativeCall, Opcode = EventOpcode.Start)]
+        public void NativeCallStart(string tracingName)
+        {
+            WriteEvent(4, tracingName);
+        }
+
+        [Event(5, Keywords = Keywords.NativeCall, Level = EventLevel.Verbose, Task = Tasks.NativeCall, Opcode = EventOpcode.Stop)]
+        public void NativeCallStop(string tracingName)
+        {
+            WriteEvent(5, tracingName);
+        }
+
+        [Event(6, Keywords = Keywords.Batch, Level = EventLevel.Verbose, Task = Tasks.Batch, Opcode = EventOpcode.Start)]
+        public void BatchStart(int callCount)
+        {
+            WriteEvent(6, callCount);
+        }
+
+        [Event(7, Keywords = Keywords.Batch, Level = EventLevel.Verbose, Task = Tasks.Batch, Opcode = EventOpcode.Stop)]
+        public void BatchStop(int callCount)
+        {
+            WriteEvent(7, callCount);
+        }
+
+        [Event(8, Keywords = Keywords.Memory, Level = EventLevel.Informational)]
+        public void HeapTrimmed(string reason, long heapSizeBefore, long heapSizeAfter)
+        {
+            WriteEvent(8, reason, heapSizeBefore, heapSizeAfter);
+        }
+
+        [Event(9, Keywords = Keywords.Queue, Level = EventLevel.Warning)]
+        public void ScriptInterrupted(string queueName, double elapsedMilliseconds)
+        {
+            WriteEvent(9, queueName, elapsedMilliseconds);
+        }
+
+        /// <summary>
+        /// Written by the invokers of <see cref="Bridge.NativeModuleBase"/>
+        /// between binding a call's arguments and running the method, so the
+        /// time since <see cref="NativeCallStart"/> is the decode time.
+        /// </summary>
+        /// <param name="tracingName">The tracing name of the method.</param>
+        [Event(10, Keywords = Keywords.NativeCall, Level = EventLevel.Verbose, Task = Tasks.NativeCall, Opcode = EventOpcode.Info)]
+        public void NativeCallArgumentsDecoded(string tracingName)
+        {
+            WriteEvent(10, tracingName);
+        }
+
+        /// <summary>
+        /// Written when an on-disk cache cannot be read or written. The
+        /// caller carries on without it.
+        /// </summary>
+        /// <param name="cacheName">The name of the cache.</param>
+        /// <param name="error">The exception, as text.</param>
+        [Event(11, Keywords = Keywords.Cache, Level = EventLevel.Warning)]
+        public void CacheFailed(string cacheName, string error)
+        {
+            WriteEvent(11, cacheName, error);
+        }
+    }
+}
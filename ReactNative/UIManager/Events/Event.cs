@@ -0,0 +1,72 @@
+﻿using Newtonsoft.Json.Linq;
+using System;
+
+namespace ReactNative.UIManager.Events
+{
+    /// <summary>
+    /// A UI event that can be dispatched to JavaScript by the
+    /// <see cref="EventDispatcher"/>.
+    /// </summary>
+    public abstract class Event
+    {
+        protected Event(int viewTag, TimeSpan timestamp)
+        {
+            ViewTag = viewTag;
+            Timestamp = timestamp;
+        }
+
+        /// <summary>
+        /// The tag of the view the event targets.
+        /// </summary>
+        public int ViewTag { get; }
+
+        /// <summary>
+        /// The time at which the event happened.
+        /// </summary>
+        public TimeSpan Timestamp { get; }
+
+        /// <summary>
+        /// The name of the event as registered in JavaScript.
+        /// </summary>
+        public abstract string EventName { get; }
+
+        /// <summary>
+        /// Whether pending events with the same target, name and
+        /// <see cref="CoalescingKey"/> can be merged into one.
+        /// </summary>
+        public virtual bool CanCoalesce
+        {
+            get
+            {
+                return true;
+            }
+        }
+
+        /// <summary>
+        /// Distinguishes events with the same target and name that must not
+        /// be coalesced with each other, e.g., different touch pointers.
+        /// </summary>
+        public virtual short CoalescingKey
+        {
+            get
+            {
+                return 0;
+            }
+        }
+
+        /// <summary>
+        /// The payload sent to JavaScript.
+        /// </summary>
+        public abstract JObject EventData { get; }
+
+        /// <summary>
+        /// Merges this event with a pending event of the same kind.
+        /// </summary>
+        /// <param name="otherEvent">The pending event.</param>
+        /// <returns>The event to keep, by default the newest one.</returns>
+        public virtual Event Coalesce(Event otherEvent)
+        {
+            return Timestamp >= otherEvent.Timestamp ? this : otherEvent;
+        }
+    }
+}
@@ -0,0 +1,163 @@
+﻿using Newtonsoft.Json.Linq;
+using ReactNative.Bridge;
+using ReactNative.Bridge.Queue;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+
+namespace ReactNative.UIManager.Events
+{
+    /// <summary>
+    /// Collects UI events, merges redundant ones and sends what remains to
+    /// JavaScript once per frame.
+    /// </summary>
+    /// <remarks>
+    /// Between two frames, a stream of events with the same target, name
+    /// and coalescing key (e.g., scroll or touch-move) is reduced to a
+    /// single event, and all pending events are sent in one bridge call.
+    /// </remarks>
+    public sealed class EventDispatcher
+    {
+        private const string EventEmitterModuleName = "RCTEventEmitter";
+        private const string ReceiveEventMethodName = "receiveEvent";
+
+        private static readonly int s_eventEmitterModuleId = GetModuleId(EventEmitterModuleName);
+        private static readonly int s_receiveEventMethodId = GetMethodId(EventEmitterModuleName, ReceiveEventMethodName);
+
+        private readonly object _gate = new object();
+        private readonly IReactBridge _bridge;
+        private readonly IMessageQueueThread _javaScriptQueueThread;
+        private readonly FrameCallback _frameCallback;
+
+        private readonly Dictionary<EventKey, int> _pendingEventIndices = new Dictionary<EventKey, int>();
+        private List<Event> _pendingEvents = new List<Event>();
+
+        public EventDispatcher(IReactBridge bridge, IMessageQueueThread javaScriptQueueThread)
+        {
+            if (bridge == null)
+                throw new ArgumentNullException(nameof(bridge));
+            if (javaScriptQueueThread == null)
+                throw new ArgumentNullException(nameof(javaScriptQueueThread));
+
+            _bridge = bridge;
+            _javaScriptQueueThread = javaScriptQueueThread;
+            _frameCallback = new FrameCallback(OnFrame);
+        }
+
+        /// <summary>
+        /// Queues an event to be sent to JavaScript on the next frame.
+        /// </summary>
+        /// <param name="event">The event.</param>
+        public void DispatchEvent(Event @event)
+        {
+            if (@event == null)
+                throw new ArgumentNullException(nameof(@event));
+
+            lock (_gate)
+            {
+                var index = default(int);
+                var key = new EventKey(@event.ViewTag, @event.EventName, @event.CoalescingKey);
+                if (@event.CanCoalesce && _pendingEventIndices.TryGetValue(key, out index))
+                {
+                    // Move the merged event to the end, where the newest
+                    // event in the stream would have been queued.
+                    var merged = @event.Coalesce(_pendingEvents[index]);
+                    _pendingEvents[index] = null;
+                    _pendingEventIndices[key] = _pendingEvents.Count;
+                    _pendingEvents.Add(merged);
+                }
+                else
+                {
+                    if (@event.CanCoalesce)
+                    {
+                        _pendingEventIndices[key] = _pendingEvents.Count;
+                    }
+
+                    _pendingEvents.Add(@event);
+                }
+            }
+
+            _frameCallback.Request();
+        }
+
+        private bool OnFrame()
+        {
+            var events = default(List<Event>);
+            lock (_gate)
+            {
+                events = _pendingEvents;
+                _pendingEvents = new List<Event>();
+                _pendingEventIndices.Clear();
+            }
+
+            var argumentsList = new List<object[]>(events.Count);
+            foreach (var @event in events)
+            {
+                if (@event != null)
+                {
+                    argumentsList.Add(new object[] { @event.ViewTag, @event.EventName, @event.EventData });
+                }
+            }
+
+            if (argumentsList.Count > 0)
+            {
+                _javaScriptQueueThread.RunOnQueue(
+                    () => _bridge.CallFunctions(s_eventEmitterModuleId, s_receiveEventMethodId, argumentsList),
+                    MessageQueuePriority.UserBlocking);
+            }
+
+            // Every pending event is sent, so no frame is needed until the next one.
+            return false;
+        }
+
+        private static int GetModuleId(string moduleName)
+        {
+            return Imports.Instance.Properties()
+                .Select(property => property.Name)
+                .ToList()
+                .IndexOf(moduleName);
+        }
+
+        private static int GetMethodId(string moduleName, string methodName)
+        {
+            return Imports.Instance[moduleName]["methods"]
+                .Select(method => method.Value<string>())
+                .ToList()
+                .IndexOf(methodName);
+        }
+
+        struct EventKey : IEquatable<EventKey>
+        {
+            private readonly int _viewTag;
+            private readonly string _eventName;
+            private readonly short _coalescingKey;
+
+            public EventKey(int viewTag, string eventName, short coalescingKey)
+            {
+                _viewTag = viewTag;
+                _eventName = eventName;
+                _coalescingKey = coalescingKey;
+            }
+
+            public bool Equals(EventKey other)
+            {
+                return _viewTag == other._viewTag
+                    && _coalescingKey == other._coalescingKey
+                    && string.Equals(_eventName, other._eventName, StringComparison.Ordinal);
+            }
+
+            public override bool Equals(object obj)
+            {
+                return obj is EventKey && Equals((EventKey)obj);
+            }
+
+            public override int GetHashCode()
+            {
+                var hash = _viewTag;
+                hash = (hash * 397) ^ _coalescingKey;
+                hash = (hash * 397) ^ (_eventName != null ? StringComparer.Ordinal.GetHashCode(_eventName) : 0);
+                return hash;
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+﻿using System;
+using Windows.ApplicationModel.Core;
+using Windows.UI.Core;
+using Windows.UI.Xaml.Media;
+
+namespace ReactNative.UIManager
+{
+    /// <summary>
+    /// Runs an action on <see cref="CompositionTarget.Rendering"/> when a
+    /// frame is requested from any thread.
+    /// </summary>
+    /// <remarks>
+    /// The rendering event is only subscribed while a frame is requested,
+    /// so the dispatcher is not woken every frame while there is no work.
+    /// The action returns whether work is left, in which case it runs again
+    /// on the next frame.
+    /// </remarks>
+    sealed class FrameCallback
+    {
+        private readonly object _gate = new object();
+        private readonly CoreDispatcher _dispatcher;
+        private readonly Func<bool> _onFrame;
+
+        private bool _isRegistered;
+
+        public FrameCallback(Func<bool> onFrame)
+        {
+            if (onFrame == null)
+                throw new ArgumentNullException(nameof(onFrame));
+
+            _onFrame = onFrame;
+            _dispatcher = CoreApplication.MainView.CoreWindow.Dispatcher;
+        }
+
+        /// <summary>
+        /// Requests that the action runs on the next frame.
+        /// </summary>
+        public void Request()
+        {
+            lock (_gate)
+            {
+                if (_isRegistered)
+                {
+                    return;
+                }
+
+                _isRegistered = true;
+            }
+
+            if (_dispatcher.HasThreadAccess)
+            {
+                CompositionTarget.Rendering += OnRendering;
+            }
+            else
+            {
+                var ignored = _dispatcher.RunAsync(
+                    CoreDispatcherPriority.High,
+                    () => CompositionTarget.Rendering += OnRendering);
+            }
+        }
+
+        private void OnRendering(object sender, object e)
+        {
+            //
+            // The event is unsubscribed before the action runs, so work
+            // enqueued while it runs requests a new frame instead of being
+            // left behind.
+            //
+            lock (_gate)
+            {
+                _isRegistered = false;
+                CompositionTarget.Rendering -= OnRendering;
+            }
+
+            if (_onFrame())
+            {
+                Request();
+            }
+        }
+    }
+}
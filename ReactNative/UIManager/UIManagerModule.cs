@@ -0,0 +1,46 @@
+﻿using ReactNative.Bridge;
+using System;
+
+namespace ReactNative.UIManager
+{
+    /// <summary>
+    /// The native module that owns the <see cref="UIViewOperationQueue"/>.
+    /// </summary>
+    /// <remarks>
+    /// The UI operations enqueued by a native call batch are handed to the
+    /// dispatcher thread when the batch completes, so the updates from one
+    /// JavaScript batch are applied together.
+    /// </remarks>
+    public sealed class UIManagerModule : NativeModuleBase, IOnBatchCompleteListener
+    {
+        /// <summary>
+        /// Instantiates the <see cref="UIManagerModule"/>.
+        /// </summary>
+        /// <param name="operationQueue">The UI operation queue.</param>
+        public UIManagerModule(UIViewOperationQueue operationQueue)
+        {
+            if (operationQueue == null)
+                throw new ArgumentNullException(nameof(operationQueue));
+
+            OperationQueue = operationQueue;
+        }
+
+        public override string Name
+        {
+            get
+            {
+                return "RCTUIManager";
+            }
+        }
+
+        /// <summary>
+        /// The queue the module's UI operations are enqueued on.
+        /// </summary>
+        public UIViewOperationQueue OperationQueue { get; }
+
+        public void OnBatchComplete()
+        {
+            OperationQueue.DispatchViewUpdates();
+        }
+    }
+}
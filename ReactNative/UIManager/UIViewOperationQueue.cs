@@ -0,0 +1,151 @@
+﻿using ReactNative.Bridge.Queue;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using Windows.UI.Xaml.Media;
+
+namespace ReactNative.UIManager
+{
+    /// <summary>
+    /// Collects the UI operations enqueued while a native call batch runs,
+    /// and applies them on the dispatcher thread in frame-aligned passes.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Operations are enqueued from the native modules thread, and handed
+    /// to the dispatcher thread as one batch by
+    /// <see cref="DispatchViewUpdates"/>, which the
+    /// <see cref="UIManagerModule"/> calls when the native call batch
+    /// completes. Batches are applied on
+    /// <see cref="CompositionTarget.Rendering"/>, so the updates from one
+    /// JavaScript batch land in the same frame and the dispatcher is woken
+    /// once per frame rather than once per operation.
+    /// </para>
+    /// <para>
+    /// Each frame applies whole batches until the frame budget is spent.
+    /// At least one batch is applied per frame, and the rest carry over to
+    /// the next frame.
+    /// </para>
+    /// <para>
+    /// An exception thrown by an operation is passed to the exception
+    /// handler, and the remaining operations still run.
+    /// </para>
+    /// </remarks>
+    public sealed class UIViewOperationQueue
+    {
+        private static readonly TimeSpan s_defaultFrameBudget = TimeSpan.FromMilliseconds(8);
+
+        private readonly object _gate = new object();
+        private readonly IQueueThreadExceptionHandler _handler;
+        private readonly long _frameBudgetTicks;
+        private readonly FrameCallback _frameCallback;
+
+        private readonly Queue<List<Action>> _pendingBatches = new Queue<List<Action>>();
+        private List<Action> _operations = new List<Action>();
+
+        /// <summary>
+        /// Instantiates the <see cref="UIViewOperationQueue"/>.
+        /// </summary>
+        /// <param name="handler">The handler for operation exceptions.</param>
+        public UIViewOperationQueue(IQueueThreadExceptionHandler handler)
+            : this(handler, s_defaultFrameBudget)
+        {
+        }
+
+        /// <summary>
+        /// Instantiates the <see cref="UIViewOperationQueue"/>.
+        /// </summary>
+        /// <param name="handler">The handler for operation exceptions.</param>
+        /// <param name="frameBudget">
+        /// The time each frame may spend applying operations.
+        /// </param>
+        public UIViewOperationQueue(IQueueThreadExceptionHandler handler, TimeSpan frameBudget)
+        {
+            if (handler == null)
+                throw new ArgumentNullException(nameof(handler));
+            if (frameBudget <= TimeSpan.Zero)
+                throw new ArgumentOutOfRangeException(nameof(frameBudget));
+
+            _handler = handler;
+            _frameBudgetTicks = (long)(frameBudget.TotalSeconds * Stopwatch.Frequency);
+            _frameCallback = new FrameCallback(OnFrame);
+        }
+
+        /// <summary>
+        /// Adds an operation to the current batch.
+        /// </summary>
+        /// <param name="operation">The operation, run on the dispatcher thread.</param>
+        public void EnqueueOperation(Action operation)
+        {
+            if (operation == null)
+                throw new ArgumentNullException(nameof(operation));
+
+            lock (_gate)
+            {
+                _operations.Add(operation);
+            }
+        }
+
+        /// <summary>
+        /// Hands the operations enqueued since the last call to the
+        /// dispatcher thread, to be applied together on a coming frame.
+        /// </summary>
+        public void DispatchViewUpdates()
+        {
+            lock (_gate)
+            {
+                if (_operations.Count == 0)
+                {
+                    return;
+                }
+
+                _pendingBatches.Enqueue(_operations);
+                _operations = new List<Action>();
+            }
+
+            _frameCallback.Request();
+        }
+
+        private bool OnFrame()
+        {
+            var start = Stopwatch.GetTimestamp();
+            do
+            {
+                var batch = default(List<Action>);
+                lock (_gate)
+                {
+                    if (_pendingBatches.Count == 0)
+                    {
+                        return false;
+                    }
+
+                    batch = _pendingBatches.Dequeue();
+                }
+
+                foreach (var operation in batch)
+                {
+                    //
+                    // An exception unwinding through the frame callback would
+                    // drop the rest of the batch and crash the app from the
+                    // rendering event, so it is reported instead.
+                    //
+                    try
+                    {
+                        operation();
+                    }
+                    catch (Exception ex)
+                    {
+                        _handler.HandleException(ex);
+                    }
+                }
+            }
+            while (Stopwatch.GetTimestamp() - start < _frameBudgetTicks);
+
+            // The batches left over carry over to the next frame.
+            lock (_gate)
+            {
+                return _pendingBatches.Count > 0;
+            }
+        }
+    }
+}